@@ -9,6 +9,13 @@
 #include <cstring>      // memcpy
 #include <imgui.h>
 #include "imgui_impl_a5.h"
+
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "This binding reads ImDrawVert as float positions and UV: IMGUI_USE_COMPACT_DRAWVERT is not supported, see the OpenGL3 example"
+#endif
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+#error "This binding binds a single texture per draw command: IMGUI_DRAWCMD_TEXTURE_SLOTS is not supported, see the software example"
+#endif
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
 
@@ -57,12 +64,16 @@ void ImGui_ImplA5_RenderDrawLists(ImDrawData* draw_data)
         }
 
         // FIXME-OPT: Unfortunately Allegro doesn't support 16-bit vertices
+        // Large draw lists are split into commands using a different vertex offset, which we fold into the 32-bit indices
         static ImVector<int> indices;
         indices.resize(cmd_list->IdxBuffer.size());
-        for (int i = 0; i < cmd_list->IdxBuffer.size(); ++i) 
-            indices[i] = (int)cmd_list->IdxBuffer.Data[i];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.size(); cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            for (int i = (int)pcmd->IdxOffset; i < (int)(pcmd->IdxOffset + pcmd->ElemCount); ++i)
+                indices[i] = (int)pcmd->VtxOffset + (int)cmd_list->IdxBuffer.Data[i];
+        }
 
-        int idx_offset = 0;
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.size(); cmd_i++) 
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
@@ -74,9 +85,8 @@ void ImGui_ImplA5_RenderDrawLists(ImDrawData* draw_data)
             {
                 ALLEGRO_BITMAP* texture = (ALLEGRO_BITMAP*)pcmd->TextureId;
                 al_set_clipping_rectangle(pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z-pcmd->ClipRect.x, pcmd->ClipRect.w-pcmd->ClipRect.y);
-                al_draw_indexed_prim(&vertices[0], g_VertexDecl, texture, &indices[idx_offset], pcmd->ElemCount, ALLEGRO_PRIM_TRIANGLE_LIST);
+                al_draw_indexed_prim(&vertices[0], g_VertexDecl, texture, &indices[pcmd->IdxOffset], pcmd->ElemCount, ALLEGRO_PRIM_TRIANGLE_LIST);
             }
-            idx_offset += pcmd->ElemCount;
         }
     }
 
@@ -0,0 +1,65 @@
+// ImGui - helpers shared by the standalone benchmarks
+
+#pragma once
+
+#include <imgui.h>
+#include <time.h>
+
+static inline double GetSeconds()
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+// Call func.Run() in batches of at least 'batch_seconds', return the time per call of the fastest batch, in nanoseconds.
+// Keeping the fastest batch filters out interruptions, which is more stable than an average for short calls.
+template<typename FUNC>
+static double MeasureBest(FUNC& func, int batches = 20, double batch_seconds = 0.002)
+{
+    int calls = 1;
+    for (;;)
+    {
+        const double t0 = GetSeconds();
+        for (int n = 0; n < calls; n++)
+            func.Run();
+        if (GetSeconds() - t0 >= batch_seconds)
+            break;
+        calls *= 2;
+    }
+    double best = 1e30;
+    for (int b = 0; b < batches; b++)
+    {
+        const double t0 = GetSeconds();
+        for (int n = 0; n < calls; n++)
+            func.Run();
+        const double t = GetSeconds() - t0;
+        if (best > t)
+            best = t;
+    }
+    return best * 1e9 / calls;
+}
+
+// Setup the default context for benchmarks filling draw lists: build the font atlas and start a frame, so draw lists have their shared data.
+static inline void InitDrawListBenchmark()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    io.Fonts->TexID = (void*)1;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = NULL;
+    ImGui::NewFrame();
+}
+
+// Clear a draw list before it grows too large, so benchmarks measure the tessellation rather than memory growth. Returns the draw list.
+static inline ImDrawList& ResetDrawList(ImDrawList& draw_list, int max_vertices = 65536)
+{
+    if (draw_list.CmdBuffer.Size == 0 || draw_list.VtxBuffer.Size > max_vertices)
+    {
+        draw_list.Clear();
+        draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+        draw_list.PushClipRectFullScreen();
+    }
+    return draw_list;
+}
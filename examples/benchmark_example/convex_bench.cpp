@@ -0,0 +1,112 @@
+// ImGui - standalone benchmark of ImDrawList::AddConvexPolyFilled()
+// Build it with and without IMGUI_DISABLE_SIMD (see Makefile) and compare the timings.
+// Anti-aliased fills of regular polygons, compared with a copy of the previous implementation (three scalar passes).
+
+#include <imgui.h>
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <imgui_internal.h>      // ImInvLength(), ImVec2 operators
+#include "benchmark.h"
+#include <math.h>
+#include <stdio.h>
+
+// Previous anti-aliased AddConvexPolyFilled(), for reference
+static void AddConvexPolyFilledReference(ImDrawList* draw_list, const ImVec2* points, const int points_count, ImU32 col)
+{
+    const ImVec2 uv = ImGui::GetDrawListSharedData()->TexUvWhitePixel;
+    const float AA_SIZE = 1.0f;
+    const ImU32 col_trans = col & 0x00ffffff;
+    const int idx_count = (points_count-2)*3 + points_count*6;
+    const int vtx_count = (points_count*2);
+    draw_list->PrimReserve(idx_count, vtx_count);
+
+    // Add indexes for fill
+    unsigned int vtx_inner_idx = draw_list->_VtxCurrentIdx;
+    unsigned int vtx_outer_idx = draw_list->_VtxCurrentIdx+1;
+    for (int i = 2; i < points_count; i++)
+    {
+        draw_list->_IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); draw_list->_IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+((i-1)<<1)); draw_list->_IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx+(i<<1));
+        draw_list->_IdxWritePtr += 3;
+    }
+
+    // Compute normals
+    ImVec2 temp_normals[64];
+    IM_ASSERT(points_count <= 64);
+    for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+    {
+        const ImVec2& p0 = points[i0];
+        const ImVec2& p1 = points[i1];
+        ImVec2 diff = p1 - p0;
+        diff *= ImInvLength(diff, 1.0f);
+        temp_normals[i0].x = diff.y;
+        temp_normals[i0].y = -diff.x;
+    }
+
+    for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+    {
+        // Average normals
+        const ImVec2& n0 = temp_normals[i0];
+        const ImVec2& n1 = temp_normals[i1];
+        ImVec2 dm = (n0 + n1) * 0.5f;
+        float dmr2 = dm.x*dm.x + dm.y*dm.y;
+        if (dmr2 > 0.000001f)
+        {
+            float scale = 1.0f / dmr2;
+            if (scale > 100.0f) scale = 100.0f;
+            dm *= scale;
+        }
+        dm *= AA_SIZE * 0.5f;
+
+        // Add vertices
+        ImDrawVertWrite(&draw_list->_VtxWritePtr[0], points[i1] - dm, uv, col);         // Inner
+        ImDrawVertWrite(&draw_list->_VtxWritePtr[1], points[i1] + dm, uv, col_trans);   // Outer
+        draw_list->_VtxWritePtr += 2;
+
+        // Add indexes for fringes
+        draw_list->_IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); draw_list->_IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); draw_list->_IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
+        draw_list->_IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); draw_list->_IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); draw_list->_IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
+        draw_list->_IdxWritePtr += 6;
+    }
+    draw_list->_VtxCurrentIdx += (ImDrawIdx)vtx_count;
+}
+
+struct BenchConvexPolyFilled
+{
+    ImDrawList* DrawList; const ImVec2* Points; int PointsCount; bool Reference;
+    void Run()
+    {
+        ImDrawList& draw_list = ResetDrawList(*DrawList);
+        if (Reference)
+            AddConvexPolyFilledReference(&draw_list, Points, PointsCount, 0xFFFFFFFF);
+        else
+            draw_list.AddConvexPolyFilled(Points, PointsCount, 0xFFFFFFFF, true);
+    }
+};
+
+int main(int, char**)
+{
+#ifdef IMGUI_DISABLE_SIMD
+    printf("AddConvexPolyFilled: scalar (IMGUI_DISABLE_SIMD)\n");
+#else
+    printf("AddConvexPolyFilled: SIMD when available\n");
+#endif
+    InitDrawListBenchmark();
+
+    ImDrawList draw_list;
+    const int counts[] = { 4, 8, 12, 16, 24, 32, 64 };
+    ImVec2 points[64];
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        const int points_count = counts[i];
+        for (int n = 0; n < points_count; n++)
+            points[n] = ImVec2(100.0f + cosf(n * 2*IM_PI / points_count) * 50.0f, 100.0f + sinf(n * 2*IM_PI / points_count) * 50.0f);
+        BenchConvexPolyFilled current = { &draw_list, points, points_count, false };
+        BenchConvexPolyFilled reference = { &draw_list, points, points_count, true };
+        const double ns_current = MeasureBest(current);
+        const double ns_reference = MeasureBest(reference);
+        printf("%2d points | previous %6.1f | current %6.1f | ns/polygon\n", points_count, ns_reference, ns_current);
+    }
+
+    ImGui::Render();
+    ImGui::Shutdown();
+    return 0;
+}
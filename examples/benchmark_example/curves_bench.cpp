@@ -0,0 +1,142 @@
+// ImGui - standalone benchmark of circles and Bezier curves tessellation
+// Compares the automatic segment count (derived from the radius/curvature and style.CurveTessellationTol) with the previous methods:
+// circles with a fixed count of 12 segments, and Bezier curves with an adaptive de Casteljau subdivision (copied below).
+// Reports vertices or points, time, and the maximum distance between the curve and its tessellation.
+
+#include <imgui.h>
+#include <imgui_internal.h>      // ImMin(), ImMax()
+#include "benchmark.h"
+#include <math.h>
+#include <stdio.h>
+
+// Previous auto-tessellation of PathBezierCurveTo(), for reference
+static void PathBezierToCasteljau(ImVector<ImVec2>* path, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, float tess_tol, int level)
+{
+    float dx = x4 - x1;
+    float dy = y4 - y1;
+    float d2 = ((x2 - x4) * dy - (y2 - y4) * dx);
+    float d3 = ((x3 - x4) * dy - (y3 - y4) * dx);
+    d2 = (d2 >= 0) ? d2 : -d2;
+    d3 = (d3 >= 0) ? d3 : -d3;
+    if ((d2+d3) * (d2+d3) < tess_tol * (dx*dx + dy*dy))
+    {
+        path->push_back(ImVec2(x4, y4));
+    }
+    else if (level < 10)
+    {
+        float x12 = (x1+x2)*0.5f,       y12 = (y1+y2)*0.5f;
+        float x23 = (x2+x3)*0.5f,       y23 = (y2+y3)*0.5f;
+        float x34 = (x3+x4)*0.5f,       y34 = (y3+y4)*0.5f;
+        float x123 = (x12+x23)*0.5f,    y123 = (y12+y23)*0.5f;
+        float x234 = (x23+x34)*0.5f,    y234 = (y23+y34)*0.5f;
+        float x1234 = (x123+x234)*0.5f, y1234 = (y123+y234)*0.5f;
+
+        PathBezierToCasteljau(path, x1,y1,        x12,y12,    x123,y123,  x1234,y1234, tess_tol, level+1);
+        PathBezierToCasteljau(path, x1234,y1234,  x234,y234,  x34,y34,    x4,y4,       tess_tol, level+1);
+    }
+}
+
+static ImVec2 BezierPoint(const ImVec2* p, float t)
+{
+    const float u = 1.0f - t;
+    const float w1 = u*u*u, w2 = 3*u*u*t, w3 = 3*u*t*t, w4 = t*t*t;
+    return ImVec2(w1*p[0].x + w2*p[1].x + w3*p[2].x + w4*p[3].x, w1*p[0].y + w2*p[1].y + w3*p[2].y + w4*p[3].y);
+}
+
+static float DistanceToSegment(const ImVec2& p, const ImVec2& a, const ImVec2& b)
+{
+    const float abx = b.x - a.x, aby = b.y - a.y, apx = p.x - a.x, apy = p.y - a.y;
+    const float len2 = abx*abx + aby*aby;
+    float t = (len2 > 0.0f) ? (apx*abx + apy*aby) / len2 : 0.0f;
+    t = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+    const float dx = apx - abx*t, dy = apy - aby*t;
+    return sqrtf(dx*dx + dy*dy);
+}
+
+// Maximum distance from a densely sampled curve to the polyline
+static float BezierMaxError(const ImVec2* p, const ImVector<ImVec2>& path)
+{
+    float max_error = 0.0f;
+    for (int s = 0; s <= 1000; s++)
+    {
+        const ImVec2 c = BezierPoint(p, s / 1000.0f);
+        float d = 1e30f;
+        for (int i = 0; i + 1 < path.Size; i++)
+            d = ImMin(d, DistanceToSegment(c, path[i], path[i+1]));
+        max_error = ImMax(max_error, d);
+    }
+    return max_error;
+}
+
+struct BenchCircleFilled
+{
+    ImDrawList* DrawList; float Radius; int NumSegments;
+    void Run() { ResetDrawList(*DrawList).AddCircleFilled(ImVec2(500, 500), Radius, 0xFFFFFFFF, NumSegments); }
+};
+
+struct BenchBezierPath
+{
+    ImDrawList* DrawList; const ImVec2* P; bool Casteljau;
+    void Run()
+    {
+        DrawList->PathClear();
+        DrawList->PathLineTo(P[0]);
+        if (Casteljau)
+            PathBezierToCasteljau(&DrawList->_Path, P[0].x, P[0].y, P[1].x, P[1].y, P[2].x, P[2].y, P[3].x, P[3].y, ImGui::GetStyle().CurveTessellationTol, 0);
+        else
+            DrawList->PathBezierCurveTo(P[1], P[2], P[3]);
+    }
+};
+
+int main(int, char**)
+{
+    InitDrawListBenchmark();
+    ImDrawList draw_list;
+    ResetDrawList(draw_list);
+
+    printf("AddCircleFilled() with CurveTessellationTol = %.2f: vertices, ns/circle, max error in pixels\n", ImGui::GetStyle().CurveTessellationTol);
+    const float radii[] = { 2.0f, 8.0f, 50.0f, 300.0f };
+    for (int i = 0; i < (int)(sizeof(radii) / sizeof(radii[0])); i++)
+    {
+        printf("  radius %5.1f", radii[i]);
+        for (int fixed = 1; fixed >= 0; fixed--)
+        {
+            BenchCircleFilled bench = { &draw_list, radii[i], fixed ? 12 : 0 };
+            ResetDrawList(draw_list);
+            const int vtx_before = draw_list.VtxBuffer.Size;
+            bench.Run();
+            const int vtx_count = draw_list.VtxBuffer.Size - vtx_before;
+            const int segments = vtx_count / 2;     // Anti-aliased fill: inner and outer vertex per point
+            const double ns = MeasureBest(bench);
+            printf(" | %s %3d vtx %6.1f ns err %5.2f", fixed ? "12 segments:" : "auto:", vtx_count, ns, radii[i] * (1.0f - cosf(3.14159265f / segments)));
+        }
+        printf("\n");
+    }
+
+    printf("PathBezierCurveTo(): points, ns/curve, max error in pixels\n");
+    const ImVec2 curves[][4] =
+    {
+        { ImVec2(10, 10),   ImVec2(20, 40),   ImVec2(40, 0),     ImVec2(50, 30) },      // Small
+        { ImVec2(100, 300), ImVec2(200, 100), ImVec2(300, 500),  ImVec2(400, 300) },    // Node editor link
+        { ImVec2(50, 900),  ImVec2(400, -200),ImVec2(1500, 1400),ImVec2(1800, 100) },   // Large
+    };
+    const char* names[] = { "small", "medium", "large" };
+    for (int i = 0; i < (int)(sizeof(curves) / sizeof(curves[0])); i++)
+    {
+        printf("  %-6s", names[i]);
+        for (int casteljau = 1; casteljau >= 0; casteljau--)
+        {
+            BenchBezierPath bench = { &draw_list, curves[i], casteljau != 0 };
+            bench.Run();
+            const int points_count = draw_list._Path.Size;
+            const float max_error = BezierMaxError(curves[i], draw_list._Path);
+            const double ns = MeasureBest(bench);
+            printf(" | %s %3d points %6.1f ns err %5.2f", casteljau ? "de Casteljau:" : "auto:", points_count, ns, max_error);
+        }
+        printf("\n");
+    }
+
+    ImGui::Render();
+    ImGui::Shutdown();
+    return 0;
+}
@@ -0,0 +1,61 @@
+// ImGui - standalone benchmark of ImHash()
+// Build it with and without IMGUI_USE_MURMUR3_HASH (see Makefile) and compare the timings.
+// Labels are 5 to 20 bytes long, like the ones passed to widgets, some of them using "##" and "###".
+
+#include <imgui.h>
+#include <imgui_internal.h>      // ImHash()
+#include "benchmark.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char* g_LabelFormats[] =
+{
+    "Node %d",              // 6-10 bytes
+    "Button %d",            // 8-12 bytes
+    "##item%d",             // 7-11 bytes
+    "Item %d###id",         // 9-15 bytes, only "###id" is hashed
+    "Checkbox %d##opt",     // 12-18 bytes
+    "Slider%d",             // 7-11 bytes
+    "Tab %d###Tab%d",       // 11-20 bytes, only "###Tab%d" is hashed
+    "Path/To/Asset_%d",     // 15-19 bytes
+};
+
+int main(int, char**)
+{
+#ifdef IMGUI_USE_MURMUR3_HASH
+    printf("ImHash: MurmurHash3 (IMGUI_USE_MURMUR3_HASH)\n");
+#else
+    printf("ImHash: CRC32\n");
+#endif
+
+    // Labels stored one after the other, zero-terminated
+    const int count = 4096;
+    ImVector<char> buf;
+    ImVector<int> offsets, lengths;
+    for (int n = 0; n < count; n++)
+    {
+        char label[64];
+        const int len = sprintf(label, g_LabelFormats[n % IM_ARRAYSIZE(g_LabelFormats)], n, n);
+        IM_ASSERT(len >= 5 && len <= 20);
+        offsets.push_back(buf.Size);
+        lengths.push_back(len);
+        for (int i = 0; i <= len; i++)
+            buf.push_back(label[i]);
+    }
+
+    const ImU32 seed = ImHash("Window", 0);
+    const int repeat = 1000;
+    for (int mode = 0; mode < 2; mode++)
+    {
+        // mode 0: zero-terminated strings (data_size==0, as Button("label")), the length and the last "###" are searched first
+        // mode 1: known length (data_size>0, as PushID(str_begin, str_end))
+        ImU32 checksum = 0;
+        const double t0 = GetSeconds();
+        for (int r = 0; r < repeat; r++)
+            for (int n = 0; n < count; n++)
+                checksum += ImHash(buf.Data + offsets[n], mode == 0 ? 0 : lengths[n], seed);
+        const double t1 = GetSeconds();
+        printf("%-20s %5.1f ns/ID (checksum %08X)\n", mode == 0 ? "zero-terminated:" : "known length:", (t1 - t0) * 1e9 / ((double)repeat * count), checksum);
+    }
+    return 0;
+}
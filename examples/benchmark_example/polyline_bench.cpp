@@ -0,0 +1,44 @@
+// ImGui - standalone benchmark of ImDrawList::AddPolyline()
+// Build it with and without IMGUI_DISABLE_SIMD (see Makefile) and compare the timings.
+// Anti-aliased strokes of a graph, thin (1 pixel: 3 vertices per point) and thick (3 pixels: 4 vertices per point).
+
+#include <imgui.h>
+#include "benchmark.h"
+#include <math.h>
+#include <stdio.h>
+
+struct BenchPolyline
+{
+    ImDrawList* DrawList; const ImVec2* Points; int PointsCount; float Thickness;
+    void Run() { ResetDrawList(*DrawList).AddPolyline(Points, PointsCount, 0xFFFFFFFF, false, Thickness, true); }
+};
+
+int main(int, char**)
+{
+#ifdef IMGUI_DISABLE_SIMD
+    printf("AddPolyline: scalar (IMGUI_DISABLE_SIMD)\n");
+#else
+    printf("AddPolyline: SIMD when available\n");
+#endif
+    InitDrawListBenchmark();
+
+    ImVector<ImVec2> points;
+    points.resize(10000);
+    for (int n = 0; n < points.Size; n++)
+        points[n] = ImVec2(10.0f + n * 0.19f, 500.0f + 300.0f * sinf(n * 0.05f));
+
+    ImDrawList draw_list;
+    const int counts[] = { 8, 100, 10000 };
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        BenchPolyline thin = { &draw_list, points.Data, counts[i], 1.0f };
+        BenchPolyline thick = { &draw_list, points.Data, counts[i], 3.0f };
+        const double ns_thin = MeasureBest(thin);
+        const double ns_thick = MeasureBest(thick);
+        printf("%5d points | thin %5.2f | thick %5.2f | ns/point\n", counts[i], ns_thin / counts[i], ns_thick / counts[i]);
+    }
+
+    ImGui::Render();
+    ImGui::Shutdown();
+    return 0;
+}
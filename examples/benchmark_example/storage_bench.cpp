@@ -0,0 +1,109 @@
+// ImGui - standalone benchmark of ImGuiStorage
+// Build it with and without IMGUI_STORAGE_USE_HASH_TABLE (see Makefile) and compare the timings.
+// Keys are TreeNode-like IDs: labels hashed with the ID of their parent, the way a window hashes its items.
+
+#include <imgui.h>
+#include <imgui_internal.h>      // ImHash()
+#include "benchmark.h"
+#include <stdio.h>
+
+// Run 'func' over 'count' keys until at least 'min_ops' operations and 0.1 seconds were timed, return nanoseconds per operation
+template<typename FUNC>
+static double Measure(FUNC& func, int count, int min_ops)
+{
+    int ops = 0;
+    const double t0 = GetSeconds();
+    double t1 = t0;
+    while (ops < min_ops || t1 - t0 < 0.1)
+    {
+        func.Run(count);
+        ops += count;
+        t1 = GetSeconds();
+    }
+    return (t1 - t0) * 1e9 / ops;
+}
+
+struct BenchSetIntNew       // SetInt() of new keys into an empty storage: what the first frame of a large tree costs
+{
+    ImGuiStorage* Storage; const ImGuiID* Ids;
+    void Run(int count) { Storage->Clear(); for (int n = 0; n < count; n++) Storage->SetInt(Ids[n], 1); }
+};
+
+struct BenchSetIntExisting  // SetInt() of existing keys: e.g. SetNextTreeNodeOpened() every frame
+{
+    ImGuiStorage* Storage; const ImGuiID* Ids;
+    void Run(int count) { for (int n = 0; n < count; n++) Storage->SetInt(Ids[n], n & 1); }
+};
+
+struct BenchGetIntHit       // GetInt() of existing keys: TreeNode() of an opened node
+{
+    ImGuiStorage* Storage; const ImGuiID* Ids; int Sum;
+    void Run(int count) { for (int n = 0; n < count; n++) Sum += Storage->GetInt(Ids[n]); }
+};
+
+struct BenchGetIntMiss      // GetInt() of missing keys: TreeNode() of a node that was never opened
+{
+    ImGuiStorage* Storage; const ImGuiID* Ids; int Sum;
+    void Run(int count) { for (int n = 0; n < count; n++) Sum += Storage->GetInt(Ids[n]); }
+};
+
+struct BenchGetIntRef       // GetIntRef() of existing keys: read-modify-write of a state
+{
+    ImGuiStorage* Storage; const ImGuiID* Ids;
+    void Run(int count) { for (int n = 0; n < count; n++) *Storage->GetIntRef(Ids[n]) ^= 1; }
+};
+
+struct BenchSetAllInt       // SetAllInt(): open/close all tree nodes. Timed per stored pair.
+{
+    ImGuiStorage* Storage; int Val;
+    void Run(int) { Storage->SetAllInt(Val ^= 1); }
+};
+
+static void RunBenchmarks(int count)
+{
+    // IDs of "Node %d" labels below a tree in a window, and the same amount of IDs of labels that are never stored
+    ImVector<ImGuiID> ids, ids_missing;
+    ids.resize(count);
+    ids_missing.resize(count);
+    const ImGuiID seed = ImHash("Tree", 0, ImHash("Window", 0));
+    for (int n = 0; n < count; n++)
+    {
+        char label[32];
+        sprintf(label, "Node %d", n);
+        ids[n] = ImHash(label, 0, seed);
+        sprintf(label, "Leaf %d", n);
+        ids_missing[n] = ImHash(label, 0, seed);
+    }
+
+    ImGuiStorage storage;
+    const int min_ops = 2000000;
+    BenchSetIntNew set_new = { &storage, ids.Data };
+    const double ns_set_new = Measure(set_new, count, count < 5000 ? min_ops : count);
+    BenchSetIntExisting set_existing = { &storage, ids.Data };
+    const double ns_set_existing = Measure(set_existing, count, min_ops);
+    BenchGetIntHit get_hit = { &storage, ids.Data, 0 };
+    const double ns_get_hit = Measure(get_hit, count, min_ops);
+    BenchGetIntMiss get_miss = { &storage, ids_missing.Data, 0 };
+    const double ns_get_miss = Measure(get_miss, count, min_ops);
+    BenchGetIntRef get_ref = { &storage, ids.Data };
+    const double ns_get_ref = Measure(get_ref, count, min_ops);
+    BenchSetAllInt set_all = { &storage, 0 };
+    const double ns_set_all = Measure(set_all, count, min_ops);
+
+    printf("%6d IDs | SetInt new %7.1f | SetInt %5.1f | GetInt hit %5.1f | GetInt miss %5.1f | GetIntRef %5.1f | SetAllInt %4.2f | ns/ID (checksum %d)\n",
+        count, ns_set_new, ns_set_existing, ns_get_hit, ns_get_miss, ns_get_ref, ns_set_all, get_hit.Sum + get_miss.Sum);
+}
+
+int main(int, char**)
+{
+#ifdef IMGUI_STORAGE_USE_HASH_TABLE
+    printf("ImGuiStorage: open-addressing hash table (IMGUI_STORAGE_USE_HASH_TABLE)\n");
+#else
+    printf("ImGuiStorage: sorted array\n");
+#endif
+    RunBenchmarks(50);
+    RunBenchmarks(500);
+    RunBenchmarks(5000);
+    RunBenchmarks(50000);
+    return 0;
+}
@@ -7,6 +7,13 @@
 #include <imgui.h>
 #include "imgui_impl_dx11.h"
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "This binding reads ImDrawVert as float positions and UV: IMGUI_USE_COMPACT_DRAWVERT is not supported, see the OpenGL3 example"
+#endif
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+#error "This binding binds a single texture per draw command: IMGUI_DRAWCMD_TEXTURE_SLOTS is not supported, see the software example"
+#endif
+
 // DirectX
 #include <d3d11.h>
 #include <d3dcompiler.h>
@@ -162,10 +169,10 @@ void ImGui_ImplDX11_RenderDrawLists(ImDrawData* draw_data)
                 const D3D11_RECT r = { (LONG)pcmd->ClipRect.x, (LONG)pcmd->ClipRect.y, (LONG)pcmd->ClipRect.z, (LONG)pcmd->ClipRect.w };
                 g_pd3dDeviceContext->PSSetShaderResources(0, 1, (ID3D11ShaderResourceView**)&pcmd->TextureId);
                 g_pd3dDeviceContext->RSSetScissorRects(1, &r); 
-                g_pd3dDeviceContext->DrawIndexed(pcmd->ElemCount, idx_offset, vtx_offset);
+                g_pd3dDeviceContext->DrawIndexed(pcmd->ElemCount, idx_offset + pcmd->IdxOffset, vtx_offset + pcmd->VtxOffset);
             }
-            idx_offset += pcmd->ElemCount;
         }
+        idx_offset += cmd_list->IdxBuffer.size();
         vtx_offset += cmd_list->VtxBuffer.size();
     }
 
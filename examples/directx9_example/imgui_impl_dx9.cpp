@@ -7,6 +7,13 @@
 #include <imgui.h>
 #include "imgui_impl_dx9.h"
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "This binding reads ImDrawVert as float positions and UV: IMGUI_USE_COMPACT_DRAWVERT is not supported, see the OpenGL3 example"
+#endif
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+#error "This binding binds a single texture per draw command: IMGUI_DRAWCMD_TEXTURE_SLOTS is not supported, see the software example"
+#endif
+
 // DirectX
 #include <d3dx9.h>
 #define DIRECTINPUT_VERSION 0x0800
@@ -128,10 +135,10 @@ void ImGui_ImplDX9_RenderDrawLists(ImDrawData* draw_data)
                 const RECT r = { (LONG)pcmd->ClipRect.x, (LONG)pcmd->ClipRect.y, (LONG)pcmd->ClipRect.z, (LONG)pcmd->ClipRect.w };
                 g_pd3dDevice->SetTexture( 0, (LPDIRECT3DTEXTURE9)pcmd->TextureId );
                 g_pd3dDevice->SetScissorRect( &r );
-                g_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, vtx_offset, 0, (UINT)cmd_list->VtxBuffer.size(), idx_offset, pcmd->ElemCount/3 );
+                g_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, vtx_offset + pcmd->VtxOffset, 0, (UINT)cmd_list->VtxBuffer.size() - pcmd->VtxOffset, idx_offset + pcmd->IdxOffset, pcmd->ElemCount/3 );
             }
-            idx_offset += pcmd->ElemCount;
         }
+        idx_offset += cmd_list->IdxBuffer.size();
         vtx_offset += cmd_list->VtxBuffer.size();
     }
 }
@@ -13,6 +13,13 @@
 #include "imgui_impl_ios.h"
 #include "imgui.h"
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "This binding reads ImDrawVert as float positions and UV: IMGUI_USE_COMPACT_DRAWVERT is not supported, see the OpenGL3 example"
+#endif
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+#error "This binding binds a single texture per draw command: IMGUI_DRAWCMD_TEXTURE_SLOTS is not supported, see the software example"
+#endif
+
 #include "uSynergy.h"
 
 // From Carbon HIToolbox/Events.h
@@ -641,6 +648,7 @@ static void ImGui_ImplIOS_RenderDrawLists (ImDrawData *draw_data)
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
     glBindVertexArray(g_VaoHandle);
     
+    #define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         ImDrawList* cmd_list = draw_data->CmdLists[n];
@@ -661,6 +669,9 @@ static void ImGui_ImplIOS_RenderDrawLists (ImDrawData *draw_data)
         memcpy(vtx_data, &cmd_list->VtxBuffer[0], cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
         glUnmapBuffer(GL_ARRAY_BUFFER);
         
+        // Large draw lists are split into commands using a different vertex offset, as 16-bit indices can only address 64K vertices.
+        // There is no glDrawElementsBaseVertex() in GLES 3.0 so we move the attribute pointers instead.
+        size_t vtx_offset = (size_t)-1;
         for (const ImDrawCmd* pcmd = cmd_list->CmdBuffer.begin(); pcmd != cmd_list->CmdBuffer.end(); pcmd++)
         {
             if (pcmd->UserCallback)
@@ -674,11 +685,18 @@ static void ImGui_ImplIOS_RenderDrawLists (ImDrawData *draw_data)
                           (int)((height - pcmd->ClipRect.w) * g_displayScale),
                           (int)((pcmd->ClipRect.z - pcmd->ClipRect.x) * g_displayScale),
                           (int)((pcmd->ClipRect.w - pcmd->ClipRect.y) * g_displayScale));
-                glDrawElements( GL_TRIANGLES, (GLsizei)pcmd->ElemCount, GL_UNSIGNED_SHORT, idx_buffer );
+                if (vtx_offset != pcmd->VtxOffset * sizeof(ImDrawVert))
+                {
+                    vtx_offset = pcmd->VtxOffset * sizeof(ImDrawVert);
+                    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + OFFSETOF(ImDrawVert, pos)));
+                    glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + OFFSETOF(ImDrawVert, uv)));
+                    glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + OFFSETOF(ImDrawVert, col)));
+                }
+                glDrawElements( GL_TRIANGLES, (GLsizei)pcmd->ElemCount, GL_UNSIGNED_SHORT, idx_buffer + pcmd->IdxOffset );
             }
-            idx_buffer += pcmd->ElemCount;
         }
     }
+    #undef OFFSETOF
     
     // Restore modified state
     glBindVertexArray(0);
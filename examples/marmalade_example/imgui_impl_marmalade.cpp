@@ -9,6 +9,13 @@
 #include <imgui.h>
 #include "imgui_impl_marmalade.h"
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "This binding reads ImDrawVert as float positions and UV: IMGUI_USE_COMPACT_DRAWVERT is not supported, see the OpenGL3 example"
+#endif
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+#error "This binding binds a single texture per draw command: IMGUI_DRAWCMD_TEXTURE_SLOTS is not supported, see the software example"
+#endif
+
 #include <s3eClipboard.h>
 #include <s3ePointer.h> 
 #include <s3eKeyboard.h>
@@ -54,11 +61,9 @@ void ImGui_Marmalade_RenderDrawLists(ImDrawData* draw_data)
             pColStream[i] = cmd_list->VtxBuffer[i].col;
         }
 
-        IwGxSetVertStreamScreenSpace(pVertStream, nVert);
-        IwGxSetUVStream(pUVStream);
-        IwGxSetColStream(pColStream, nVert);
         IwGxSetNormStream(0);
 
+        unsigned int vtx_offset = (unsigned int)-1;
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.size(); cmd_i++)
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
@@ -77,9 +82,16 @@ void ImGui_Marmalade_RenderDrawLists(ImDrawData* draw_data)
                 pCurrentMaterial->SetAlphaTestMode(CIwMaterial::ALPHATEST_DISABLED);
                 pCurrentMaterial->SetTexture((CIwTexture*)pcmd->TextureId);
                 IwGxSetMaterial(pCurrentMaterial);
-                IwGxDrawPrims(IW_GX_TRI_LIST, (uint16*)idx_buffer, pcmd->ElemCount);
+                if (vtx_offset != pcmd->VtxOffset)
+                {
+                    // Large draw lists are split into commands using a different vertex offset, as 16-bit indices can only address 64K vertices
+                    vtx_offset = pcmd->VtxOffset;
+                    IwGxSetVertStreamScreenSpace(pVertStream + vtx_offset, nVert - vtx_offset);
+                    IwGxSetUVStream(pUVStream + vtx_offset);
+                    IwGxSetColStream(pColStream + vtx_offset, nVert - vtx_offset);
+                }
+                IwGxDrawPrims(IW_GX_TRI_LIST, (uint16*)(idx_buffer + pcmd->IdxOffset), pcmd->ElemCount);
             }
-            idx_buffer += pcmd->ElemCount;
         }
         IwGxFlush();
     }
@@ -7,6 +7,10 @@
 #include <imgui.h>
 #include "imgui_impl_glfw_gl3.h"
 
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+#error "This binding binds a single texture per draw command: IMGUI_DRAWCMD_TEXTURE_SLOTS is not supported, see the software example"
+#endif
+
 // GL3W/GLFW
 #include <GL/gl3w.h>
 #include <GLFW/glfw3.h>
@@ -24,7 +28,7 @@ static bool         g_MousePressed[3] = { false, false, false };
 static float        g_MouseWheel = 0.0f;
 static GLuint       g_FontTexture = 0;
 static int          g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
-static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
+static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0, g_AttribLocationTransform = 0;
 static int          g_AttribLocationPosition = 0, g_AttribLocationUV = 0, g_AttribLocationColor = 0;
 static unsigned int g_VboHandle = 0, g_VaoHandle = 0, g_ElementsHandle = 0;
 
@@ -63,6 +67,11 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
     draw_data->ScaleClipRects(io.DisplayFramebufferScale);
 
     // Setup orthographic projection matrix
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const float pos_scale = 1.0f / IM_DRAWVERT_POS_SCALE;  // Compact vertices store positions as fixed point integers, we fold the conversion into the transform
+#else
+    const float pos_scale = 1.0f;
+#endif
     const float ortho_projection[4][4] =
     {
         { 2.0f/io.DisplaySize.x, 0.0f,                   0.0f, 0.0f },
@@ -75,16 +84,18 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
     glBindVertexArray(g_VaoHandle);
 
+    // Upload the vertices/indices of all command lists at once
+    draw_data->ConsolidateBuffers();
+    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)draw_data->VtxBuffer.size() * sizeof(ImDrawVert), (GLvoid*)draw_data->VtxBuffer.Data, GL_STREAM_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)draw_data->IdxBuffer.size() * sizeof(ImDrawIdx), (GLvoid*)draw_data->IdxBuffer.Data, GL_STREAM_DRAW);
+
+    ImVec4 last_transform(0.0f, 0.0f, 0.0f, 0.0f);  // Never a valid transform, so the first command sets it
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        const ImDrawIdx* idx_buffer_offset = 0;
-
-        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.size() * sizeof(ImDrawVert), (GLvoid*)&cmd_list->VtxBuffer.front(), GL_STREAM_DRAW);
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx), (GLvoid*)&cmd_list->IdxBuffer.front(), GL_STREAM_DRAW);
+        const ImDrawIdx* idx_buffer_offset = (const ImDrawIdx*)0 + draw_data->CmdListsIdxOffset[n];
 
         for (const ImDrawCmd* pcmd = cmd_list->CmdBuffer.begin(); pcmd != cmd_list->CmdBuffer.end(); pcmd++)
         {
@@ -94,11 +105,16 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
             }
             else
             {
+                // Vertices positions are transformed by 'pos * scale + translate' (ImDrawCmd::Transform, identity unless ImDrawList::PushTransform() was used)
+                if (pcmd->Transform.x != last_transform.x || pcmd->Transform.y != last_transform.y || pcmd->Transform.z != last_transform.z || pcmd->Transform.w != last_transform.w)
+                {
+                    last_transform = pcmd->Transform;
+                    glUniform4f(g_AttribLocationTransform, pcmd->Transform.x * pos_scale, pcmd->Transform.y * pos_scale, pcmd->Transform.z, pcmd->Transform.w);
+                }
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
                 glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, GL_UNSIGNED_SHORT, idx_buffer_offset);
+                glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, GL_UNSIGNED_SHORT, idx_buffer_offset + pcmd->IdxOffset, (GLint)(draw_data->CmdListsVtxOffset[n] + pcmd->VtxOffset));
             }
-            idx_buffer_offset += pcmd->ElemCount;
         }
     }
 
@@ -193,6 +209,7 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
     const GLchar *vertex_shader =
         "#version 330\n"
         "uniform mat4 ProjMtx;\n"
+        "uniform vec4 Transform;\n"
         "in vec2 Position;\n"
         "in vec2 UV;\n"
         "in vec4 Color;\n"
@@ -202,7 +219,7 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
         "{\n"
         "	Frag_UV = UV;\n"
         "	Frag_Color = Color;\n"
-        "	gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+        "	gl_Position = ProjMtx * vec4(Position.xy * Transform.xy + Transform.zw,0,1);\n"
         "}\n";
 
     const GLchar* fragment_shader =
@@ -229,6 +246,7 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
 
     g_AttribLocationTex = glGetUniformLocation(g_ShaderHandle, "Texture");
     g_AttribLocationProjMtx = glGetUniformLocation(g_ShaderHandle, "ProjMtx");
+    g_AttribLocationTransform = glGetUniformLocation(g_ShaderHandle, "Transform");
     g_AttribLocationPosition = glGetAttribLocation(g_ShaderHandle, "Position");
     g_AttribLocationUV = glGetAttribLocation(g_ShaderHandle, "UV");
     g_AttribLocationColor = glGetAttribLocation(g_ShaderHandle, "Color");
@@ -244,8 +262,13 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
     glEnableVertexAttribArray(g_AttribLocationColor);
 
 #define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_SHORT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(g_AttribLocationUV, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
+#else
     glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
     glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
+#endif
     glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
 #undef OFFSETOF
 
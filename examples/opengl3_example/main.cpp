@@ -48,6 +48,7 @@ int main(int, char**)
 
     bool show_test_window = true;
     bool show_another_window = false;
+    bool show_canvas_window = false;
     ImVec4 clear_color = ImColor(114, 144, 154);
 
     // Main loop
@@ -65,6 +66,7 @@ int main(int, char**)
             ImGui::ColorEdit3("clear color", (float*)&clear_color);
             if (ImGui::Button("Test Window")) show_test_window ^= 1;
             if (ImGui::Button("Another Window")) show_another_window ^= 1;
+            if (ImGui::Button("Canvas Window")) show_canvas_window ^= 1;
             ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         }
 
@@ -84,6 +86,54 @@ int main(int, char**)
             ImGui::ShowTestWindow(&show_test_window);
         }
 
+        // 4. Show a canvas which can be panned (drag) and zoomed (mouse wheel). Its content is submitted in its own space and the renderer applies the transform,
+        // so with ImGuiWindowFlags_CachedDrawList panning and zooming reuse the vertices of the previous frame instead of tessellating them again.
+        if (show_canvas_window)
+        {
+            static ImVec2 scrolling(0.0f, 0.0f);
+            static float zoom = 1.0f;
+            ImGuiIO& io = ImGui::GetIO();
+            ImGui::Begin("Canvas", &show_canvas_window, ImVec2(400,400), -1.0f, ImGuiWindowFlags_CachedDrawList);
+            ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+            ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+            ImGui::InvisibleButton("##canvas", canvas_size);
+            if (ImGui::IsItemActive())
+            {
+                scrolling.x += io.MouseDelta.x;
+                scrolling.y += io.MouseDelta.y;
+            }
+            if (ImGui::IsItemHovered() && io.MouseWheel != 0.0f)
+            {
+                // Zoom around the mouse cursor
+                float new_zoom = zoom * (io.MouseWheel > 0.0f ? 1.25f : 0.8f);
+                new_zoom = (new_zoom < 0.1f) ? 0.1f : (new_zoom > 10.0f) ? 10.0f : new_zoom;
+                ImVec2 mouse(io.MousePos.x - canvas_pos.x, io.MousePos.y - canvas_pos.y);
+                scrolling.x = mouse.x - (mouse.x - scrolling.x) * new_zoom / zoom;
+                scrolling.y = mouse.y - (mouse.y - scrolling.y) * new_zoom / zoom;
+                zoom = new_zoom;
+            }
+
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            draw_list->PushClipRect(ImVec4(canvas_pos.x, canvas_pos.y, canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y));
+            draw_list->PushTransform(ImVec2(canvas_pos.x + scrolling.x, canvas_pos.y + scrolling.y), ImVec2(zoom, zoom));
+            for (int i = 0; i <= 20; i++)
+            {
+                draw_list->AddLine(ImVec2(i * 50.0f, 0.0f), ImVec2(i * 50.0f, 1000.0f), ImColor(200,200,200,40));
+                draw_list->AddLine(ImVec2(0.0f, i * 50.0f), ImVec2(1000.0f, i * 50.0f), ImColor(200,200,200,40));
+            }
+            for (int i = 0; i < 100; i++)
+            {
+                char label[32];
+                sprintf(label, "Node %d", i);
+                ImVec2 pos((i % 10) * 100.0f + 10.0f, (i / 10) * 100.0f + 10.0f);
+                draw_list->AddRectFilled(pos, ImVec2(pos.x + 80.0f, pos.y + 40.0f), ImColor(60,60,70), 4.0f);
+                draw_list->AddText(ImVec2(pos.x + 8.0f, pos.y + 12.0f), ImColor(255,255,255), label);
+            }
+            draw_list->PopTransform();
+            draw_list->PopClipRect();
+            ImGui::End();
+        }
+
         // Rendering
         int display_w, display_h;
         glfwGetFramebufferSize(window, &display_w, &display_h);
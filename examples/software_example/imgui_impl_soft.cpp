@@ -0,0 +1,218 @@
+// ImGui software renderer
+// Rasterize the draw data into a RGBA32 buffer in memory, without GPU or window. It is slow, but simple enough to be used as a reference: to test your application headless, take screenshots, or compare the output of your own renderer.
+// You can copy and use unmodified imgui_impl_* files in your project.
+// If you use this binding you'll need to call 4 functions: ImGui_ImplSoft_Init(), ImGui_ImplSoft_NewFrame(), ImGui::Render() and ImGui_ImplSoft_Shutdown().
+// See main.cpp for an example of using this.
+// https://github.com/ocornut/imgui
+
+#include <imgui.h>
+#include "imgui_impl_soft.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Data
+static unsigned int*            g_Framebuffer = NULL;
+static int                      g_Width = 0, g_Height = 0;
+static int                      g_DrawCallsCount = 0;
+static ImGui_ImplSoft_Texture   g_FontTexture;
+
+static inline ImVec2 GetVertexUV(const ImDrawVert& v)
+{
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    return ImVec2(v.uv[0] / 65535.0f, v.uv[1] / 65535.0f);
+#else
+    return v.uv;
+#endif
+}
+
+// Nearest texel, clamped to the edges. A NULL texture reads as opaque white.
+static inline void SampleTexture(const ImGui_ImplSoft_Texture* tex, float u, float v, float out_rgba[4])
+{
+    if (!tex)
+    {
+        out_rgba[0] = out_rgba[1] = out_rgba[2] = out_rgba[3] = 1.0f;
+        return;
+    }
+    int x = (int)(u * tex->Width), y = (int)(v * tex->Height);
+    x = (x < 0) ? 0 : (x >= tex->Width) ? tex->Width - 1 : x;
+    y = (y < 0) ? 0 : (y >= tex->Height) ? tex->Height - 1 : y;
+    const unsigned int c = tex->Pixels[y * tex->Width + x];
+    for (int ch = 0; ch < 4; ch++)
+        out_rgba[ch] = ((c >> (ch * 8)) & 0xFF) / 255.0f;
+}
+
+static inline float EdgeFunction(const ImVec2& a, const ImVec2& b, float x, float y)
+{
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+// Pixels exactly on an edge belong to the triangle on its top or left side only, so that triangles sharing an edge don't blend twice over it (same rule as GPUs)
+static inline bool IsEdgeTopLeft(const ImVec2& a, const ImVec2& b)
+{
+    return (a.y == b.y && b.x < a.x) || (b.y > a.y);
+}
+
+static inline ImVec2 TransformPos(const ImVec2& pos, const ImVec4& transform)
+{
+    return ImVec2(pos.x * transform.x + transform.z, pos.y * transform.y + transform.w);
+}
+
+// Alpha blended, with texture and vertex color multiplied, like the other examples (src_alpha, one_minus_src_alpha)
+static void RasterizeTriangle(const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec4& transform, const ImGui_ImplSoft_Texture* tex, int clip_x0, int clip_y0, int clip_x1, int clip_y1)
+{
+    ImVec2 p[3] = { TransformPos(ImDrawVertGetPos(*v0), transform), TransformPos(ImDrawVertGetPos(*v1), transform), TransformPos(ImDrawVertGetPos(*v2), transform) };
+    float area = EdgeFunction(p[0], p[1], p[2].x, p[2].y);
+    if (area == 0.0f)
+        return;
+    const ImDrawVert* vtx[3] = { v0, v1, v2 };
+    if (area < 0.0f)
+    {
+        ImVec2 tmp_p = p[1]; p[1] = p[2]; p[2] = tmp_p;
+        const ImDrawVert* tmp_v = vtx[1]; vtx[1] = vtx[2]; vtx[2] = tmp_v;
+        area = -area;
+    }
+
+    ImVec2 uv[3];
+    float col[3][4];
+    for (int k = 0; k < 3; k++)
+    {
+        uv[k] = GetVertexUV(*vtx[k]);
+        for (int ch = 0; ch < 4; ch++)
+            col[k][ch] = ((vtx[k]->col >> (ch * 8)) & 0xFF) / 255.0f;
+    }
+    const bool top_left[3] = { IsEdgeTopLeft(p[1], p[2]), IsEdgeTopLeft(p[2], p[0]), IsEdgeTopLeft(p[0], p[1]) };
+
+    // Bounding box of the pixel centers, clipped to the scissor rectangle
+    float min_x = p[0].x, min_y = p[0].y, max_x = p[0].x, max_y = p[0].y;
+    for (int k = 1; k < 3; k++)
+    {
+        min_x = (p[k].x < min_x) ? p[k].x : min_x; max_x = (p[k].x > max_x) ? p[k].x : max_x;
+        min_y = (p[k].y < min_y) ? p[k].y : min_y; max_y = (p[k].y > max_y) ? p[k].y : max_y;
+    }
+    int x0 = (int)(min_x - 0.5f) - 1, y0 = (int)(min_y - 0.5f) - 1, x1 = (int)(max_x + 0.5f) + 1, y1 = (int)(max_y + 0.5f) + 1;
+    x0 = (x0 < clip_x0) ? clip_x0 : x0; y0 = (y0 < clip_y0) ? clip_y0 : y0;
+    x1 = (x1 > clip_x1) ? clip_x1 : x1; y1 = (y1 > clip_y1) ? clip_y1 : y1;
+
+    for (int y = y0; y < y1; y++)
+    {
+        unsigned int* dst = g_Framebuffer + y * g_Width;
+        for (int x = x0; x < x1; x++)
+        {
+            const float px = x + 0.5f, py = y + 0.5f;
+            const float e0 = EdgeFunction(p[1], p[2], px, py), e1 = EdgeFunction(p[2], p[0], px, py), e2 = EdgeFunction(p[0], p[1], px, py);
+            if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f)
+                continue;
+            if ((e0 == 0.0f && !top_left[0]) || (e1 == 0.0f && !top_left[1]) || (e2 == 0.0f && !top_left[2]))
+                continue;
+            const float w0 = e0 / area, w1 = e1 / area, w2 = e2 / area;
+
+            float texel[4];
+            SampleTexture(tex, w0 * uv[0].x + w1 * uv[1].x + w2 * uv[2].x, w0 * uv[0].y + w1 * uv[1].y + w2 * uv[2].y, texel);
+            float src[4];
+            for (int ch = 0; ch < 4; ch++)
+                src[ch] = (w0 * col[0][ch] + w1 * col[1][ch] + w2 * col[2][ch]) * texel[ch];
+
+            unsigned int out = dst[x] & 0xFF000000;
+            for (int ch = 0; ch < 3; ch++)
+            {
+                const float d = ((dst[x] >> (ch * 8)) & 0xFF) / 255.0f;
+                const float r = src[ch] * src[3] + d * (1.0f - src[3]);
+                out |= (unsigned int)(r * 255.0f + 0.5f) << (ch * 8);
+            }
+            dst[x] = out;
+        }
+    }
+}
+
+void ImGui_ImplSoft_RenderDrawLists(ImDrawData* draw_data)
+{
+    // Clear to opaque black
+    for (int i = 0; i < g_Width * g_Height; i++)
+        g_Framebuffer[i] = 0xFF000000;
+    g_DrawCallsCount = 0;
+
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+            {
+                pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+            g_DrawCallsCount++;
+
+            // Same rounding as glScissor() in the OpenGL examples
+            int clip_x0 = (int)pcmd->ClipRect.x, clip_y0 = (int)pcmd->ClipRect.y;
+            int clip_x1 = clip_x0 + (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), clip_y1 = clip_y0 + (int)(pcmd->ClipRect.w - pcmd->ClipRect.y);
+            clip_x0 = (clip_x0 < 0) ? 0 : clip_x0; clip_y0 = (clip_y0 < 0) ? 0 : clip_y0;
+            clip_x1 = (clip_x1 > g_Width) ? g_Width : clip_x1; clip_y1 = (clip_y1 > g_Height) ? g_Height : clip_y1;
+
+            const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int i = 0; i < pcmd->ElemCount; i += 3)
+            {
+                const ImDrawVert* v0 = &vtx_buffer[idx_buffer[i]];
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+                // The vertices of a triangle always use the same slot
+                const ImGui_ImplSoft_Texture* tex = (const ImGui_ImplSoft_Texture*)pcmd->TextureIds[v0->tex];
+#else
+                const ImGui_ImplSoft_Texture* tex = (const ImGui_ImplSoft_Texture*)pcmd->TextureId;
+#endif
+                RasterizeTriangle(v0, &vtx_buffer[idx_buffer[i+1]], &vtx_buffer[idx_buffer[i+2]], pcmd->Transform, tex, clip_x0, clip_y0, clip_x1, clip_y1);
+            }
+        }
+    }
+}
+
+const unsigned int* ImGui_ImplSoft_GetFramebuffer(int* out_width, int* out_height)
+{
+    if (out_width) *out_width = g_Width;
+    if (out_height) *out_height = g_Height;
+    return g_Framebuffer;
+}
+
+int ImGui_ImplSoft_GetDrawCallsCount()
+{
+    return g_DrawCallsCount;
+}
+
+bool ImGui_ImplSoft_Init(int width, int height)
+{
+    g_Width = width;
+    g_Height = height;
+    g_Framebuffer = (unsigned int*)malloc(width * height * sizeof(unsigned int));
+    if (!g_Framebuffer)
+        return false;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.RenderDrawListsFn = ImGui_ImplSoft_RenderDrawLists;  // Alternatively you can set this to NULL and call ImGui::GetDrawData() after ImGui::Render() to get the same ImDrawData pointer.
+
+    // Build texture atlas. We keep a pointer to the atlas pixels, so don't clear them.
+    unsigned char* pixels;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &g_FontTexture.Width, &g_FontTexture.Height);
+    g_FontTexture.Pixels = (const unsigned int*)pixels;
+    io.Fonts->TexID = (void*)&g_FontTexture;
+
+    return true;
+}
+
+void ImGui_ImplSoft_Shutdown()
+{
+    ImGui::Shutdown();
+    free(g_Framebuffer);
+    g_Framebuffer = NULL;
+    g_Width = g_Height = 0;
+}
+
+void ImGui_ImplSoft_NewFrame(float delta_time)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = delta_time;
+
+    // Start the frame
+    ImGui::NewFrame();
+}
@@ -0,0 +1,21 @@
+// ImGui software renderer
+// Rasterize the draw data into a RGBA32 buffer in memory, without GPU or window. It is slow, but simple enough to be used as a reference: to test your application headless, take screenshots, or compare the output of your own renderer.
+// You can copy and use unmodified imgui_impl_* files in your project.
+// If you use this binding you'll need to call 4 functions: ImGui_ImplSoft_Init(), ImGui_ImplSoft_NewFrame(), ImGui::Render() and ImGui_ImplSoft_Shutdown().
+// See main.cpp for an example of using this.
+// https://github.com/ocornut/imgui
+
+// What an ImTextureID points to. Pixels are RGBA32 (same byte order as ImU32 colors), and aren't copied.
+struct ImGui_ImplSoft_Texture
+{
+    int                 Width, Height;
+    const unsigned int* Pixels;
+};
+
+IMGUI_API bool                  ImGui_ImplSoft_Init(int width, int height);
+IMGUI_API void                  ImGui_ImplSoft_Shutdown();
+IMGUI_API void                  ImGui_ImplSoft_NewFrame(float delta_time);
+
+// Result of the last call to ImGui::Render(), RGBA32 with a 'width * 4' bytes pitch.
+IMGUI_API const unsigned int*   ImGui_ImplSoft_GetFramebuffer(int* out_width, int* out_height);
+IMGUI_API int                   ImGui_ImplSoft_GetDrawCallsCount();     // Number of draw commands (excluding callbacks) executed by the last call to ImGui::Render()
@@ -0,0 +1,96 @@
+// ImGui - standalone example application for the software renderer
+// Render a few frames without window or GPU, and save the last one to 'imgui.ppm'.
+
+#include <imgui.h>
+#include "imgui_impl_soft.h"
+#include <stdio.h>
+
+// A few checkerboard textures, standing for the thumbnails of an asset browser
+static unsigned int             g_ThumbnailPixels[8][16*16];
+static ImGui_ImplSoft_Texture   g_Thumbnails[8];
+static int                      g_ThumbnailIcons[8];
+
+static void CreateThumbnails()
+{
+    for (int n = 0; n < 8; n++)
+    {
+        const ImU32 col = ImGui::ColorConvertFloat4ToU32(ImVec4((n & 1) ? 1.0f : 0.3f, (n & 2) ? 1.0f : 0.3f, (n & 4) ? 1.0f : 0.3f, 1.0f));
+        for (int y = 0; y < 16; y++)
+            for (int x = 0; x < 16; x++)
+                g_ThumbnailPixels[n][y * 16 + x] = (((x / 4) + (y / 4)) & 1) ? col : 0xFF404040;
+        g_Thumbnails[n].Width = g_Thumbnails[n].Height = 16;
+        g_Thumbnails[n].Pixels = g_ThumbnailPixels[n];
+
+        // Same pixels packed into the font atlas, must be done before the atlas is built
+        g_ThumbnailIcons[n] = ImGui::GetIO().Fonts->AddIcon(16, 16, g_ThumbnailPixels[n]);
+    }
+}
+
+static bool SavePPM(const char* filename)
+{
+    int width, height;
+    const unsigned int* pixels = ImGui_ImplSoft_GetFramebuffer(&width, &height);
+    FILE* f = fopen(filename, "wb");
+    if (!f)
+        return false;
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    for (int i = 0; i < width * height; i++)
+    {
+        const unsigned char rgb[3] = { (unsigned char)(pixels[i] & 0xFF), (unsigned char)((pixels[i] >> 8) & 0xFF), (unsigned char)((pixels[i] >> 16) & 0xFF) };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int, char**)
+{
+    // Setup ImGui binding
+    CreateThumbnails();
+    if (!ImGui_ImplSoft_Init(1280, 720))
+        return 1;
+
+    bool show_test_window = true;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImGui_ImplSoft_NewFrame(1.0f/60.0f);
+
+        ImGui::SetNextWindowPos(ImVec2(650, 20), ImGuiSetCond_FirstUseEver);
+        ImGui::ShowTestWindow(&show_test_window);
+
+        // Many images using different textures
+        ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiSetCond_FirstUseEver);
+        ImGui::Begin("Thumbnails", NULL, ImVec2(600, 660));
+        for (int i = 0; i < 200; i++)
+        {
+            ImGui::Image((ImTextureID)&g_Thumbnails[i % 8], ImVec2(24, 24));
+            if ((i % 20) != 19)
+                ImGui::SameLine();
+        }
+
+        // Same images using the font atlas texture, they are drawn along with the text
+        ImGui::Separator();
+        ImGui::Text("Icons packed in the font atlas:");
+        ImGuiIO& io = ImGui::GetIO();
+        for (int i = 0; i < 200; i++)
+        {
+            ImVec2 uv0, uv1;
+            io.Fonts->GetIconTexUV(g_ThumbnailIcons[i % 8], &uv0, &uv1);
+            ImGui::Image(io.Fonts->TexID, ImVec2(24, 24), uv0, uv1);
+            if ((i % 20) != 19)
+                ImGui::SameLine();
+        }
+        ImGui::End();
+
+        ImGui::Render();
+    }
+
+    printf("%d draw calls\n", ImGui_ImplSoft_GetDrawCallsCount());
+    if (!SavePPM("imgui.ppm"))
+        printf("Failed to write imgui.ppm\n");
+
+    // Cleanup
+    ImGui_ImplSoft_Shutdown();
+
+    return 0;
+}
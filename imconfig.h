@@ -29,6 +29,27 @@
 //---- Don't define obsolete functions names
 //#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 
+//---- Use an open-addressing hash table for ImGuiStorage instead of a sorted array (O(1) lookup/insertion, but ImGuiStorage::Data[] becomes unordered and contains empty slots)
+//#define IMGUI_STORAGE_USE_HASH_TABLE
+
+//---- Use MurmurHash3 (4 bytes per iteration) instead of a table-driven CRC32 (1 byte per iteration) in ImHash(), used to compute widget IDs every frame
+//#define IMGUI_USE_MURMUR3_HASH
+
+//---- Enable IMGUI_ID("literal") to hash string literals at compile time, and the GetID()/PushID() overloads taking the resulting ImGuiIdHash. Requires C++11.
+//#define IMGUI_USE_CONSTEXPR_ID
+
+//---- Make the current context (ImGui::SetCurrentContext) thread-local, so independent contexts can be used concurrently from different threads
+//#define IMGUI_USE_THREAD_LOCAL_CONTEXT
+
+//---- Use a 12 bytes ImDrawVert instead of 20 bytes: 16-bit fixed point positions and 16-bit normalized UV. Your renderer needs to be adapted, see ImDrawVert in imgui.h and the OpenGL3 example.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+
+//---- Let a draw command sample up to N textures, selected per vertex by ImDrawVert::tex, so images and font using different textures can share one draw call. Your renderer needs to be adapted, see ImDrawCmd in imgui.h and the software example.
+//#define IMGUI_DRAWCMD_TEXTURE_SLOTS   8
+
+//---- Don't use the SSE2/NEON code paths of ImDrawList tessellation (scalar code produces the same output)
+//#define IMGUI_DISABLE_SIMD
+
 //---- Implement STB libraries in a namespace to avoid conflicts
 //#define IMGUI_STB_NAMESPACE     ImGuiStb
 
@@ -144,6 +144,12 @@
  Here is a change-log of API breaking changes, if you are using one of the functions listed, expect to have to fix some code.
  Also read releases logs https://github.com/ocornut/imgui/releases for more details.
 
+ - 2015/09/xx (1.46) - added ImDrawCmd::Transform, set by ImDrawList::PushTransform(). vertices of a command using it are given in a local space and need to be mapped with 'pos * scale + translate'.
+                       if you have your own rendering function, you need to apply pcmd->Transform (e.g. in your projection matrix or in a shader uniform), otherwise transformed content is drawn at its local position.
+ - 2015/09/xx (1.46) - added ImDrawCmd::VtxOffset. with 16-bit indices, a draw list holding more than 64K vertices is now split into commands indexing from different vertex offsets.
+                       if you have your own rendering function, you need to add pcmd->VtxOffset to the indices of each command (e.g. base vertex parameter, or offset your vertex pointer/stream).
+ - 2015/09/xx (1.46) - added ImDrawCmd::IdxOffset. ImDrawList::IdxBuffer may now contain unused ranges (after channels were merged, e.g. when using Columns) and commands aren't necessarily stored in index order.
+                       if you have your own rendering function, you need to start each command at idx_buffer + pcmd->IdxOffset instead of summing the ElemCount of the previous commands.
  - 2015/08/29 (1.45) - with the addition of horizontal scrollbar we made various fixes to inconsistencies with dealing with cursor position.
                        GetCursorPos()/SetCursorPos() functions now include the scrolled amount. It shouldn't affect the majority of users, but take note that SetCursorPosX(100.0f) puts you at +100 from the starting x position which may include scrolling, not at +100 from the window left side.
                        GetContentRegionMax()/GetWindowContentRegionMin()/GetWindowContentRegionMax() functions allow include the scrolled amount. Typically those were used in cases where no scrolling would happen so it may not be a problem, but watch out!
@@ -518,6 +524,10 @@
 #include <stdint.h>     // intptr_t
 #endif
 
+#ifdef _MSC_VER
+#include <intrin.h>     // _InterlockedExchange, _InterlockedIncrement
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (disable: 4127) // condition expression is constant
 #pragma warning (disable: 4505) // unreferenced local function has been removed (stb stuff)
@@ -553,6 +563,9 @@ static void             PushMultiItemsWidths(int components, float w_full = 0.0f
 static float            GetDraggedColumnOffset(int column_index);
 
 static bool             IsKeyPressedMap(ImGuiKey key, bool repeat = true);
+static bool             HasInputChangedSinceLastFrame();
+static void             UpdateIdleState();
+static void             UpdateInputEvents();
 
 static void             SetCurrentFont(ImFont* font);
 static void             SetCurrentWindow(ImGuiWindow* window);
@@ -614,9 +627,10 @@ static void             ImeSetInputScreenPosFn_DefaultImpl(int x, int y);
 //-----------------------------------------------------------------------------
 
 // We access everything through this pointer (always assumed to be != NULL)
-// You can swap the pointer to a different context by calling ImGui::SetInternalState()
+// You can swap the pointer to a different context by calling ImGui::SetCurrentContext() or ImGui::SetInternalState()
+// With IMGUI_USE_THREAD_LOCAL_CONTEXT the pointer is per-thread, and every thread starts pointing to the default context.
 static ImGuiState       GImDefaultState;
-ImGuiState*             GImGui = &GImDefaultState;
+IMGUI_THREAD_LOCAL ImGuiState* GImGui = &GImDefaultState;
 
 // Statically allocated default font atlas. This is merely a maneuver to keep ImFontAtlas definition at the bottom of the .h file (otherwise it'd be inside ImGuiIO)
 // Also we wouldn't be able to new() one at this point, before users may define IO.MemAllocFn.
@@ -724,6 +738,8 @@ ImGuiIO::ImGuiIO()
     KeyRepeatDelay = 0.250f;
     KeyRepeatRate = 0.050f;
     UserData = NULL;
+    WantRedraw = true;
+    RedrawDelay = 0.0f;
 
     // User functions
     RenderDrawListsFn = NULL;
@@ -757,6 +773,89 @@ void ImGuiIO::AddInputCharactersUTF8(const char* utf8_chars)
         AddInputCharacter(wchars[i]);
 }
 
+// Minimal spin lock for the input events queue. Held for very short durations.
+static void LockInputEvents(volatile long* lock)
+{
+#ifdef _MSC_VER
+    while (_InterlockedExchange(lock, 1) != 0) {}
+#else
+    while (__sync_lock_test_and_set(lock, 1) != 0) {}
+#endif
+}
+
+static void UnlockInputEvents(volatile long* lock)
+{
+#ifdef _MSC_VER
+    _InterlockedExchange(lock, 0);
+#else
+    __sync_lock_release(lock);
+#endif
+}
+
+// Thread-safe. Storage is allocated with this ImGuiIO's allocator directly, not through the current context which may differ on other threads.
+void ImGuiIO::AddInputEvent(const ImGuiInputEvent& e)
+{
+    LockInputEvents(&InputEventsLock);
+    if (InputEventsSize == InputEventsCapacity)
+    {
+        const int new_capacity = InputEventsCapacity ? InputEventsCapacity * 2 : 64;
+        ImGuiInputEvent* new_data = (ImGuiInputEvent*)MemAllocFn((size_t)new_capacity * sizeof(ImGuiInputEvent));
+        if (InputEvents)
+        {
+            memcpy(new_data, InputEvents, (size_t)InputEventsSize * sizeof(ImGuiInputEvent));
+            MemFreeFn(InputEvents);
+        }
+        InputEvents = new_data;
+        InputEventsCapacity = new_capacity;
+    }
+    InputEvents[InputEventsSize++] = e;
+    UnlockInputEvents(&InputEventsLock);
+}
+
+static ImGuiInputEvent MakeInputEvent(ImGuiInputEventType type, int index, bool down, float x, float y, double time)
+{
+    ImGuiInputEvent e;
+    e.Type = type;
+    e.Index = index;
+    e.Down = down;
+    e.X = x;
+    e.Y = y;
+    e.Time = time;
+    return e;
+}
+
+void ImGuiIO::AddMousePosEvent(float x, float y, double time)
+{
+    AddInputEvent(MakeInputEvent(ImGuiInputEventType_MousePos, 0, false, x, y, time));
+}
+
+void ImGuiIO::AddMouseButtonEvent(int button, bool down, double time)
+{
+    IM_ASSERT(button >= 0 && button < IM_ARRAYSIZE(MouseDown));
+    AddInputEvent(MakeInputEvent(ImGuiInputEventType_MouseButton, button, down, 0.0f, 0.0f, time));
+}
+
+void ImGuiIO::AddMouseWheelEvent(float wheel, double time)
+{
+    AddInputEvent(MakeInputEvent(ImGuiInputEventType_MouseWheel, 0, false, wheel, 0.0f, time));
+}
+
+void ImGuiIO::AddKeyEvent(int key_index, bool down, double time)
+{
+    IM_ASSERT(key_index >= 0 && key_index < IM_ARRAYSIZE(KeysDown));
+    AddInputEvent(MakeInputEvent(ImGuiInputEventType_Key, key_index, down, 0.0f, 0.0f, time));
+}
+
+void ImGuiIO::AddKeyModsEvent(bool ctrl, bool shift, bool alt, double time)
+{
+    AddInputEvent(MakeInputEvent(ImGuiInputEventType_KeyMods, (ctrl ? 1 : 0) | (shift ? 2 : 0) | (alt ? 4 : 0), false, 0.0f, 0.0f, time));
+}
+
+void ImGuiIO::AddCharEvent(ImWchar c, double time)
+{
+    AddInputEvent(MakeInputEvent(ImGuiInputEventType_Char, (int)c, false, 0.0f, 0.0f, time));
+}
+
 //-----------------------------------------------------------------------------
 // HELPERS
 //-----------------------------------------------------------------------------
@@ -854,8 +953,67 @@ int ImFormatStringV(char* buf, int buf_size, const char* fmt, va_list args)
     return (w == -1) ? buf_size : w;
 }
 
+#ifdef IMGUI_USE_MURMUR3_HASH
+
+static inline ImU32 ImRotl32(ImU32 x, int r) { return (x << r) | (x >> (32 - r)); }
+
 // Pass data_size==0 for zero-terminated strings
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// MurmurHash3 (x86_32 variant), consuming 4 bytes per iteration. Words are assembled explicitly so the result doesn't depend on alignment or endianness.
+ImU32 ImHash(const void* data, int data_size, ImU32 seed)
+{
+    const unsigned char* current = (const unsigned char*)data;
+    if (data_size <= 0)
+    {
+        // Zero-terminated string
+        // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+        // Same as the CRC32 version: we hash from the last occurrence of ### (which is also what resetting to the seed on every ### does).
+        // Labels are short: a single inline scan is faster than strlen() followed by memchr().
+        const char* p = (const char*)data;
+        for (; *p; p++)
+            if (*p == '#' && p[1] == '#' && p[2] == '#')
+                current = (const unsigned char*)p;
+        data_size = (int)(p - (const char*)current);
+    }
+
+    const ImU32 c1 = 0xcc9e2d51;
+    const ImU32 c2 = 0x1b873593;
+    ImU32 h = seed;
+    const int nblocks = data_size / 4;
+    for (int i = 0; i < nblocks; i++, current += 4)
+    {
+        ImU32 k = (ImU32)current[0] | ((ImU32)current[1] << 8) | ((ImU32)current[2] << 16) | ((ImU32)current[3] << 24);
+        k *= c1;
+        k = ImRotl32(k, 15);
+        k *= c2;
+        h ^= k;
+        h = ImRotl32(h, 13);
+        h = h * 5 + 0xe6546b64;
+    }
+
+    if (const int tail = data_size & 3)
+    {
+        ImU32 k = (ImU32)current[0];
+        if (tail >= 2) k |= (ImU32)current[1] << 8;
+        if (tail == 3) k |= (ImU32)current[2] << 16;
+        k *= c1;
+        k = ImRotl32(k, 15);
+        k *= c2;
+        h ^= k;
+    }
+
+    h ^= (ImU32)data_size;
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+#else // #ifdef IMGUI_USE_MURMUR3_HASH
+
+// Pass data_size==0 for zero-terminated strings
+// FIXME-OPT: CRC32 pretty much randomly access 1KB. Define IMGUI_USE_MURMUR3_HASH in imconfig.h to use a word-at-a-time hash instead.
 ImU32 ImHash(const void* data, int data_size, ImU32 seed)
 {
     static ImU32 crc32_lut[256] = { 0 };
@@ -899,6 +1057,8 @@ ImU32 ImHash(const void* data, int data_size, ImU32 seed)
     return ~crc;
 }
 
+#endif // #ifdef IMGUI_USE_MURMUR3_HASH
+
 //-----------------------------------------------------------------------------
 // ImText* helpers
 //-----------------------------------------------------------------------------
@@ -1188,6 +1348,159 @@ void* ImLoadFileToMemory(const char* filename, const char* file_open_mode, int*
 //-----------------------------------------------------------------------------
 
 // Helper: Key->value storage
+#ifdef IMGUI_STORAGE_USE_HASH_TABLE
+
+void ImGuiStorage::Clear()
+{
+    Data.clear();
+    DataCount = 0;
+    ZeroKeyUsed = false;
+}
+
+// Keys are typically already hashed but user code may store sequential integers: scramble them before masking (murmur3 finalizer)
+static inline ImU32 StorageHashKey(ImGuiID key)
+{
+    key ^= key >> 16;
+    key *= 0x85ebca6b;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35;
+    key ^= key >> 16;
+    return key;
+}
+
+// Return the pair holding 'key', or NULL if missing
+static ImGuiStorage::Pair* StorageFind(const ImGuiStorage& storage, ImGuiID key)
+{
+    if (storage.Data.Size == 0)
+        return NULL;
+    ImGuiStorage::Pair* data = storage.Data.Data;
+    const int zero_slot = storage.Data.Size - 1;
+    if (key == 0)
+        return storage.ZeroKeyUsed ? &data[zero_slot] : NULL;
+    const ImU32 mask = (ImU32)zero_slot - 1;
+    for (ImU32 i = StorageHashKey(key) & mask; ; i = (i + 1) & mask)
+    {
+        if (data[i].key == key)
+            return &data[i];
+        if (data[i].key == 0)
+            return NULL;
+    }
+}
+
+static void StorageInsertNoGrow(ImGuiStorage& storage, const ImGuiStorage::Pair& pair, ImGuiStorage::Pair** out_slot)
+{
+    ImGuiStorage::Pair* data = storage.Data.Data;
+    const int zero_slot = storage.Data.Size - 1;
+    ImGuiStorage::Pair* slot;
+    if (pair.key == 0)
+    {
+        slot = &data[zero_slot];
+        storage.ZeroKeyUsed = true;
+    }
+    else
+    {
+        const ImU32 mask = (ImU32)zero_slot - 1;
+        ImU32 i = StorageHashKey(pair.key) & mask;
+        while (data[i].key != 0)
+            i = (i + 1) & mask;
+        slot = &data[i];
+    }
+    *slot = pair;
+    storage.DataCount++;
+    if (out_slot)
+        *out_slot = slot;
+}
+
+// Find the pair holding 'pair.key', insert 'pair' if missing. Keep the load factor under 3/4.
+static ImGuiStorage::Pair* StorageFindOrInsert(ImGuiStorage& storage, const ImGuiStorage::Pair& pair)
+{
+    if (ImGuiStorage::Pair* slot = StorageFind(storage, pair.key))
+        return slot;
+
+    const int capacity = storage.Data.Size > 0 ? storage.Data.Size - 1 : 0;
+    if ((storage.DataCount + 1) * 4 > capacity * 3)
+    {
+        // Rehash into a table twice as large
+        const int new_capacity = capacity > 0 ? capacity * 2 : 16;
+        ImVector<ImGuiStorage::Pair> old_data;
+        old_data.swap(storage.Data);
+        const bool old_zero_key_used = storage.ZeroKeyUsed;
+        storage.Data.resize(new_capacity + 1);
+        memset(storage.Data.Data, 0, (size_t)storage.Data.Size * sizeof(ImGuiStorage::Pair));
+        storage.DataCount = 0;
+        storage.ZeroKeyUsed = false;
+        for (int i = 0; i < capacity; i++)
+            if (old_data[i].key != 0)
+                StorageInsertNoGrow(storage, old_data[i], NULL);
+        if (old_zero_key_used)
+            StorageInsertNoGrow(storage, old_data[capacity], NULL);
+    }
+
+    ImGuiStorage::Pair* slot;
+    StorageInsertNoGrow(storage, pair, &slot);
+    return slot;
+}
+
+int ImGuiStorage::GetInt(ImU32 key, int default_val) const
+{
+    const Pair* it = StorageFind(*this, key);
+    return it ? it->val_i : default_val;
+}
+
+float ImGuiStorage::GetFloat(ImU32 key, float default_val) const
+{
+    const Pair* it = StorageFind(*this, key);
+    return it ? it->val_f : default_val;
+}
+
+void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
+{
+    const Pair* it = StorageFind(*this, key);
+    return it ? it->val_p : NULL;
+}
+
+// References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
+{
+    return &StorageFindOrInsert(*this, Pair(key, default_val))->val_i;
+}
+
+float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
+{
+    return &StorageFindOrInsert(*this, Pair(key, default_val))->val_f;
+}
+
+void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
+{
+    return &StorageFindOrInsert(*this, Pair(key, default_val))->val_p;
+}
+
+void ImGuiStorage::SetInt(ImU32 key, int val)
+{
+    StorageFindOrInsert(*this, Pair(key, val))->val_i = val;
+}
+
+void ImGuiStorage::SetFloat(ImU32 key, float val)
+{
+    StorageFindOrInsert(*this, Pair(key, val))->val_f = val;
+}
+
+void ImGuiStorage::SetVoidPtr(ImU32 key, void* val)
+{
+    StorageFindOrInsert(*this, Pair(key, val))->val_p = val;
+}
+
+void ImGuiStorage::SetAllInt(int v)
+{
+    for (int i = 0; i < Data.Size - 1; i++)
+        if (Data[i].key != 0)
+            Data[i].val_i = v;
+    if (ZeroKeyUsed)
+        Data.back().val_i = v;
+}
+
+#else // #ifdef IMGUI_STORAGE_USE_HASH_TABLE
+
 void ImGuiStorage::Clear()
 {
     Data.clear();
@@ -1305,6 +1618,8 @@ void ImGuiStorage::SetAllInt(int v)
         Data[i].val_i = v;
 }
 
+#endif // #ifdef IMGUI_STORAGE_USE_HASH_TABLE
+
 //-----------------------------------------------------------------------------
 // ImGuiTextFilter
 //-----------------------------------------------------------------------------
@@ -1445,6 +1760,107 @@ void ImGuiTextBuffer::append(const char* fmt, ...)
     va_end(args);
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiFrameArena
+//-----------------------------------------------------------------------------
+
+void* ImGuiFrameArena::Alloc(int size)
+{
+    IM_ASSERT(size >= 0);
+    int offset = (CurrentOffset + 7) & ~7;
+    if (Blocks.Size == 0 || offset + size > BlockSizes.back())
+    {
+        int block_size = Blocks.Size > 0 ? BlockSizes.back() * 2 : 16*1024;
+        if (block_size < size)
+            block_size = size;
+        Blocks.push_back((char*)ImGui::MemAlloc((size_t)block_size));
+        BlockSizes.push_back(block_size);
+        offset = 0;
+    }
+    char* ptr = Blocks.back() + offset;
+    CurrentOffset = offset + size;
+    LastAlloc = ptr;
+    return ptr;
+}
+
+void ImGuiFrameArena::Free(void* ptr)
+{
+    if (ptr != NULL && ptr == LastAlloc)
+    {
+        CurrentOffset = (int)((char*)ptr - Blocks.back());
+        LastAlloc = NULL;
+    }
+}
+
+// Format into the arena without truncation. The first attempt writes into the remaining space of the current block, which is likely to succeed.
+char* ImGuiFrameArena::FormatV(const char* fmt, va_list args, const char** out_end)
+{
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    const int offset = (CurrentOffset + 7) & ~7;
+    const int avail = (Blocks.Size > 0 && BlockSizes.back() > offset) ? BlockSizes.back() - offset : 0;
+    char* buf = avail > 0 ? Blocks.back() + offset : NULL;
+    int len = vsnprintf(buf, (size_t)avail, fmt, args);
+    if (len < 0)
+        len = 0;
+    if (len + 1 <= avail)
+    {
+        buf = (char*)Alloc(len + 1);
+    }
+    else
+    {
+        buf = (char*)Alloc(len + 1);
+        vsnprintf(buf, (size_t)(len + 1), fmt, args_copy);
+    }
+    va_end(args_copy);
+    buf[len] = 0;
+
+    if (out_end)
+        *out_end = buf + len;
+    return buf;
+}
+
+void ImGuiFrameArena::Reset()
+{
+    if (Blocks.Size > 1)
+    {
+        // Last frame didn't fit in one block: merge into a single block large enough for it
+        int total_size = GetCapacity();
+        Clear();
+        Blocks.push_back((char*)ImGui::MemAlloc((size_t)total_size));
+        BlockSizes.push_back(total_size);
+    }
+    CurrentOffset = 0;
+    LastAlloc = NULL;
+}
+
+void ImGuiFrameArena::Clear()
+{
+    for (int i = 0; i < Blocks.Size; i++)
+        ImGui::MemFree(Blocks[i]);
+    Blocks.clear();
+    BlockSizes.clear();
+    CurrentOffset = 0;
+    LastAlloc = NULL;
+}
+
+int ImGuiFrameArena::GetUsedSize() const
+{
+    int size = CurrentOffset;
+    for (int i = 0; i < BlockSizes.Size - 1; i++)
+        size += BlockSizes[i];
+    return size;
+}
+
+int ImGuiFrameArena::GetCapacity() const
+{
+    int size = 0;
+    for (int i = 0; i < BlockSizes.Size; i++)
+        size += BlockSizes[i];
+    return size;
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiSimpleColumns
 //-----------------------------------------------------------------------------
@@ -1521,6 +1937,7 @@ ImGuiWindow::ImGuiWindow(const char* name)
     AutoFitOnlyGrows = false;
     AutoPosLastDirection = -1;
     HiddenFrames = 0;
+    Occluded = false;
     SetWindowPosAllowFlags = SetWindowSizeAllowFlags = SetWindowCollapsedAllowFlags = ImGuiSetCond_Always | ImGuiSetCond_Once | ImGuiSetCond_FirstUseEver | ImGuiSetCond_Appearing;
     SetWindowPosCenterWanted = false;
 
@@ -1529,7 +1946,7 @@ ImGuiWindow::ImGuiWindow(const char* name)
     FontWindowScale = 1.0f;
 
     DrawList = (ImDrawList*)ImGui::MemAlloc(sizeof(ImDrawList));
-    new(DrawList) ImDrawList();
+    new(DrawList) ImDrawList(&GImGui->DrawListSharedData);
     DrawList->_OwnerName = Name;
     RootWindow = NULL;
     RootNonPopupWindow = NULL;
@@ -1564,6 +1981,17 @@ ImGuiID ImGuiWindow::GetID(const void* ptr)
     return id;
 }
 
+#ifdef IMGUI_USE_CONSTEXPR_ID
+// The string was hashed ahead of time without seed, we only need to combine its 4 bytes with the current seed.
+ImGuiID ImGuiWindow::GetID(ImGuiIdHash id_hash)
+{
+    ImGuiID seed = IDStack.back();
+    ImGuiID id = ImHash(&id_hash.Value, sizeof(id_hash.Value), seed);
+    ImGui::KeepAliveID(id);
+    return id;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // Internal API exposed in imgui_internal.h
 //-----------------------------------------------------------------------------
@@ -1573,7 +2001,7 @@ static void SetCurrentWindow(ImGuiWindow* window)
     ImGuiState& g = *GImGui;
     g.CurrentWindow = window;
     if (window)
-        g.FontSize = window->CalcFontSize();
+        g.FontSize = g.DrawListSharedData.FontSize = window->CalcFontSize();
 }
 
 ImGuiWindow* ImGui::GetParentWindow()
@@ -1760,15 +2188,27 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 
 //-----------------------------------------------------------------------------
 
+// The allocation counter is updated atomically, as draw lists may be built on other threads (see ImDrawListSharedData)
 void* ImGui::MemAlloc(size_t sz)
 {
-    GImGui->IO.MetricsAllocs++;
+#ifdef _MSC_VER
+    _InterlockedIncrement((volatile long*)&GImGui->IO.MetricsAllocs);
+#else
+    __sync_fetch_and_add(&GImGui->IO.MetricsAllocs, 1);
+#endif
     return GImGui->IO.MemAllocFn(sz);
 }
 
 void ImGui::MemFree(void* ptr)
 {
-    if (ptr) GImGui->IO.MetricsAllocs--;
+    if (ptr)
+    {
+#ifdef _MSC_VER
+        _InterlockedDecrement((volatile long*)&GImGui->IO.MetricsAllocs);
+#else
+        __sync_fetch_and_sub(&GImGui->IO.MetricsAllocs, 1);
+#endif
+    }
     return GImGui->IO.MemFreeFn(ptr);
 }
 
@@ -1807,6 +2247,52 @@ void ImGui::SetInternalState(void* state, bool construct)
     GImGui = (ImGuiState*)state;
 }
 
+// Create a context, using 'malloc_fn'/'free_fn' for all its allocations (defaults to malloc/free). Doesn't change the current context.
+// Unlike the default context, io.IniFilename defaults to NULL: give each context its own file if you want its settings saved.
+// By default the new context uses the shared default font atlas in io.Fonts. The atlas is never modified by ImGui once built,
+// so multiple contexts (possibly used from different threads with IMGUI_USE_THREAD_LOCAL_CONTEXT) can share it, as long as it is built beforehand.
+ImGuiState* ImGui::CreateContext(void* (*malloc_fn)(size_t), void (*free_fn)(void*))
+{
+    if (!malloc_fn)
+        malloc_fn = malloc;
+    ImGuiState* ctx = (ImGuiState*)malloc_fn(sizeof(ImGuiState));
+    new(ctx) ImGuiState();
+    ctx->IO.MemAllocFn = malloc_fn;
+    ctx->IO.MemFreeFn = free_fn ? free_fn : free;
+
+    // Don't let contexts running on different threads load and save the same "imgui.ini" concurrently
+    ctx->IO.IniFilename = NULL;
+
+    // Build lazily initialized static tables now, so they are not built concurrently by contexts running on different threads
+    ImHash("", 0);
+    return ctx;
+}
+
+// Shutdown and free a context created with CreateContext(). io.Fonts is left untouched as it may be shared, destroy your own atlas yourself.
+// If 'ctx' was the current context, the default context becomes current.
+void ImGui::DestroyContext(ImGuiState* ctx)
+{
+    IM_ASSERT(ctx != NULL && ctx != &GImDefaultState);
+    ImGuiState* backup_ctx = GImGui;
+    GImGui = ctx;
+    ctx->IO.Fonts = NULL;
+    Shutdown();
+    void (*free_fn)(void*) = ctx->IO.MemFreeFn;
+    ctx->~ImGuiState();     // Vectors free their memory through ImGui::MemFree(), so 'ctx' needs to be current until here
+    GImGui = (backup_ctx == ctx) ? &GImDefaultState : backup_ctx;
+    free_fn(ctx);
+}
+
+ImGuiState* ImGui::GetCurrentContext()
+{
+    return GImGui;
+}
+
+void ImGui::SetCurrentContext(ImGuiState* ctx)
+{
+    GImGui = ctx ? ctx : &GImDefaultState;
+}
+
 ImGuiIO& ImGui::GetIO()
 {
     return GImGui->IO;
@@ -1833,6 +2319,182 @@ int ImGui::GetFrameCount()
     return GImGui->FrameCount;
 }
 
+// Compare inputs submitted in g.IO with the state recorded by the last NewFrame()
+static bool HasInputChangedSinceLastFrame()
+{
+    ImGuiState& g = *GImGui;
+    const ImGuiIO& io = g.IO;
+    if (!g.Initialized)
+        return true;
+    if (io.MouseWheel != 0.0f || io.InputCharacters[0] != 0)
+        return true;
+    const bool mouse_valid = !(io.MousePos.x < 0 && io.MousePos.y < 0);
+    const bool mouse_valid_prev = !(io.MousePosPrev.x < 0 && io.MousePosPrev.y < 0);
+    if (mouse_valid != mouse_valid_prev || (mouse_valid && (io.MousePos.x != io.MousePosPrev.x || io.MousePos.y != io.MousePosPrev.y)))
+        return true;
+    for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown); i++)
+        if (io.MouseDown[i] != (io.MouseDownDuration[i] >= 0.0f))
+            return true;
+    for (int i = 0; i < IM_ARRAYSIZE(io.KeysDown); i++)
+        if (io.KeysDown[i] != (io.KeysDownDuration[i] >= 0.0f))
+            return true;
+    if (io.KeyCtrl != g.IdlePrevKeyMods[0] || io.KeyShift != g.IdlePrevKeyMods[1] || io.KeyAlt != g.IdlePrevKeyMods[2])
+        return true;
+    if (io.DisplaySize.x != g.IdlePrevDisplaySize.x || io.DisplaySize.y != g.IdlePrevDisplaySize.y)
+        return true;
+    return false;
+}
+
+static bool HasQueuedInputEvents()
+{
+    ImGuiIO& io = GImGui->IO;
+    LockInputEvents(&io.InputEventsLock);
+    const bool queued = io.InputEventsSize > 0;
+    UnlockInputEvents(&io.InputEventsLock);
+    return queued;
+}
+
+bool ImGui::IsNewFrameNeeded(float elapsed_time)
+{
+    ImGuiState& g = *GImGui;
+    return g.IO.WantRedraw || elapsed_time >= g.IO.RedrawDelay || g.FrameCountRendered != g.FrameCount || HasInputChangedSinceLastFrame() || HasQueuedInputEvents();
+}
+
+// Called at the end of the frame: figure out if a following frame could differ from this one without new inputs
+static void UpdateIdleState()
+{
+    ImGuiState& g = *GImGui;
+    bool want_redraw = (g.IdleInputFrame == g.FrameCount);
+
+    // NewFrame() applies a single change per key or button: the rest of the queued events need more frames
+    want_redraw |= HasQueuedInputEvents();
+
+    // Held buttons and keys trigger repeats and durations
+    for (int i = 0; i < IM_ARRAYSIZE(g.IO.MouseDown) && !want_redraw; i++)
+        want_redraw |= g.IO.MouseDown[i];
+    for (int i = 0; i < IM_ARRAYSIZE(g.IO.KeysDown) && !want_redraw; i++)
+        want_redraw |= g.IO.KeysDown[i];
+
+    // Active widget (a text input only needs its cursor to blink), modal darkening animation
+    const bool text_input_active = (g.ActiveId != 0 && g.ActiveId == g.InputTextState.Id);
+    if (g.ActiveId != 0 && !text_input_active)
+        want_redraw = true;
+    if (g.ModalWindowDarkeningRatio > 0.0f && g.ModalWindowDarkeningRatio < 1.0f)
+        want_redraw = true;
+
+    // Windows still settling their layout (auto-fit, appearing)
+    for (int i = 0; i < g.Windows.Size && !want_redraw; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (window->Active && (window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 || window->HiddenFrames > 0))
+            want_redraw = true;
+    }
+
+    float redraw_delay = FLT_MAX;
+    if (g.SettingsDirtyTimer > 0.0f && g.IO.IniFilename)
+        redraw_delay = ImMin(redraw_delay, g.SettingsDirtyTimer);
+    if (text_input_active)
+    {
+        // Matches cursor_is_visible in InputTextEx(): visible while CursorAnim <= 0.0f, then blinking 0.80 on / 0.40 off
+        const float anim = g.InputTextState.CursorAnim;
+        const float t = (anim <= 0.0f) ? 0.0f : fmodf(anim, 1.20f);
+        const float blink_delay = (anim <= 0.0f) ? (-anim + 0.80f) : (t <= 0.80f ? 0.80f - t : 1.20f - t);
+        redraw_delay = ImMin(redraw_delay, blink_delay);
+    }
+
+    g.IO.WantRedraw = want_redraw;
+    g.IO.RedrawDelay = want_redraw ? 0.0f : redraw_delay;
+}
+
+// Apply queued input events to the io state. A same key/button changing twice, a mouse move after a button change, or characters overflowing InputCharacters[] end the frame's events: the rest is kept for the next frames.
+static void UpdateInputEvents()
+{
+    ImGuiState& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    for (int i = 0; i < IM_ARRAYSIZE(g.InputEventsMouseClickTime); i++)
+        g.InputEventsMouseClickTime[i] = -1.0;
+
+    LockInputEvents(&io.InputEventsLock);
+    ImU32 keys_changed[IM_ARRAYSIZE(io.KeysDown) / 32];
+    memset(keys_changed, 0, sizeof(keys_changed));
+    int mouse_buttons_changed = 0;
+    bool key_mods_changed = false;
+    int chars_count = ImStrlenW(io.InputCharacters);
+    int n = 0;
+    for (; n < io.InputEventsSize; n++)
+    {
+        const ImGuiInputEvent& e = io.InputEvents[n];
+        if (e.Type == ImGuiInputEventType_MousePos)
+        {
+            if (mouse_buttons_changed != 0)
+                break;
+            io.MousePos = ImVec2(e.X, e.Y);
+        }
+        else if (e.Type == ImGuiInputEventType_MouseButton)
+        {
+            if (mouse_buttons_changed & (1 << e.Index))
+                break;
+            if (io.MouseDown[e.Index] != e.Down)
+            {
+                io.MouseDown[e.Index] = e.Down;
+                mouse_buttons_changed |= 1 << e.Index;
+                if (e.Down)
+                    g.InputEventsMouseClickTime[e.Index] = e.Time;
+            }
+        }
+        else if (e.Type == ImGuiInputEventType_MouseWheel)
+        {
+            io.MouseWheel += e.X;
+        }
+        else if (e.Type == ImGuiInputEventType_Key)
+        {
+            if (keys_changed[e.Index >> 5] & (1u << (e.Index & 31)))
+                break;
+            if (!g.InputEventsKeysUsed)
+            {
+                // Switching to queued keys: start tracking the keys currently down
+                g.InputEventsKeysUsed = true;
+                for (int i = 0; i < IM_ARRAYSIZE(io.KeysDown); i++)
+                    if (io.KeysDownDuration[i] >= 0.0f)
+                        g.KeysDownTracked.push_back(i);
+            }
+            if (io.KeysDown[e.Index] != e.Down)
+            {
+                io.KeysDown[e.Index] = e.Down;
+                keys_changed[e.Index >> 5] |= 1u << (e.Index & 31);
+                if (e.Down && io.KeysDownDuration[e.Index] < 0.0f && io.KeysDownDurationPrev[e.Index] < 0.0f)
+                    g.KeysDownTracked.push_back(e.Index);
+            }
+        }
+        else if (e.Type == ImGuiInputEventType_KeyMods)
+        {
+            if (key_mods_changed)
+                break;
+            const bool ctrl = (e.Index & 1) != 0, shift = (e.Index & 2) != 0, alt = (e.Index & 4) != 0;
+            if (io.KeyCtrl != ctrl || io.KeyShift != shift || io.KeyAlt != alt)
+            {
+                io.KeyCtrl = ctrl;
+                io.KeyShift = shift;
+                io.KeyAlt = alt;
+                key_mods_changed = true;
+            }
+        }
+        else if (e.Type == ImGuiInputEventType_Char)
+        {
+            if (chars_count + 1 >= IM_ARRAYSIZE(io.InputCharacters))
+                break;
+            io.InputCharacters[chars_count++] = (ImWchar)e.Index;
+            io.InputCharacters[chars_count] = 0;
+        }
+    }
+    if (n > 0)
+    {
+        io.InputEventsSize -= n;
+        memmove(io.InputEvents, io.InputEvents + n, (size_t)io.InputEventsSize * sizeof(ImGuiInputEvent));
+    }
+    UnlockInputEvents(&io.InputEventsLock);
+}
+
 void ImGui::NewFrame()
 {
     ImGuiState& g = *GImGui;
@@ -1856,10 +2518,23 @@ void ImGui::NewFrame()
     }
 
     SetCurrentFont(g.IO.Fonts->Fonts[0]);
+    g.DrawListSharedData.CurveTessellationTol = g.Style.CurveTessellationTol;
+    g.DrawListSharedData.AntiAliasedLines = g.Style.AntiAliasedLines;
+    g.DrawListSharedData.AntiAliasedShapes = g.Style.AntiAliasedShapes;
+    UpdateInputEvents();
+
+    // Idle detection: record input changes before we update the input state
+    if (HasInputChangedSinceLastFrame())
+        g.IdleInputFrame = g.FrameCount + 1;
+    g.IdlePrevDisplaySize = g.IO.DisplaySize;
+    g.IdlePrevKeyMods[0] = g.IO.KeyCtrl;
+    g.IdlePrevKeyMods[1] = g.IO.KeyShift;
+    g.IdlePrevKeyMods[2] = g.IO.KeyAlt;
 
     g.Time += g.IO.DeltaTime;
     g.FrameCount += 1;
-    g.Tooltip[0] = '\0';
+    g.FrameArena.Reset();
+    g.Tooltip = NULL;
     g.OverlayDrawList.Clear();
     g.OverlayDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.OverlayDrawList.PushClipRectFullScreen();
@@ -1887,15 +2562,21 @@ void ImGui::NewFrame()
         g.IO.MouseDoubleClicked[i] = false;
         if (g.IO.MouseClicked[i])
         {
-            if (g.Time - g.IO.MouseClickedTime[i] < g.IO.MouseDoubleClickTime)
+            // Event timestamps come from the user's clock: only compare them when both clicks have one, otherwise use frame time
+            const double event_time = g.InputEventsMouseClickTime[i];
+            const double prev_event_time = g.InputEventsMouseClickedTime[i];
+            const double click_delta = (event_time >= 0.0 && prev_event_time >= 0.0) ? event_time - prev_event_time : (double)(g.Time - g.IO.MouseClickedTime[i]);
+            if (click_delta < g.IO.MouseDoubleClickTime)
             {
                 if (ImLengthSqr(g.IO.MousePos - g.IO.MouseClickedPos[i]) < g.IO.MouseDoubleClickMaxDist * g.IO.MouseDoubleClickMaxDist)
                     g.IO.MouseDoubleClicked[i] = true;
                 g.IO.MouseClickedTime[i] = -FLT_MAX;    // so the third click isn't turned into a double-click
+                g.InputEventsMouseClickedTime[i] = -1.0;
             }
             else
             {
                 g.IO.MouseClickedTime[i] = g.Time;
+                g.InputEventsMouseClickedTime[i] = event_time;
             }
             g.IO.MouseClickedPos[i] = g.IO.MousePos;
             g.IO.MouseDragMaxDistanceSqr[i] = 0.0f;
@@ -1905,9 +2586,31 @@ void ImGui::NewFrame()
             g.IO.MouseDragMaxDistanceSqr[i] = ImMax(g.IO.MouseDragMaxDistanceSqr[i], ImLengthSqr(g.IO.MousePos - g.IO.MouseClickedPos[i]));
         }
     }
-    memcpy(g.IO.KeysDownDurationPrev, g.IO.KeysDownDuration, sizeof(g.IO.KeysDownDuration));
-    for (int i = 0; i < IM_ARRAYSIZE(g.IO.KeysDown); i++)
-        g.IO.KeysDownDuration[i] = g.IO.KeysDown[i] ? (g.IO.KeysDownDuration[i] < 0.0f ? 0.0f : g.IO.KeysDownDuration[i] + g.IO.DeltaTime) : -1.0f;
+    if (g.InputEventsKeysUsed)
+    {
+        // Keys come from the input queue so we know which ones can have a duration: other keys stay at -1.0f
+        for (int n = 0; n < g.KeysDownTracked.Size; )
+        {
+            const int i = g.KeysDownTracked[n];
+            g.IO.KeysDownDurationPrev[i] = g.IO.KeysDownDuration[i];
+            g.IO.KeysDownDuration[i] = g.IO.KeysDown[i] ? (g.IO.KeysDownDuration[i] < 0.0f ? 0.0f : g.IO.KeysDownDuration[i] + g.IO.DeltaTime) : -1.0f;
+            if (g.IO.KeysDownDuration[i] < 0.0f && g.IO.KeysDownDurationPrev[i] < 0.0f)
+            {
+                g.KeysDownTracked[n] = g.KeysDownTracked.back();
+                g.KeysDownTracked.pop_back();
+            }
+            else
+            {
+                n++;
+            }
+        }
+    }
+    else
+    {
+        memcpy(g.IO.KeysDownDurationPrev, g.IO.KeysDownDuration, sizeof(g.IO.KeysDownDuration));
+        for (int i = 0; i < IM_ARRAYSIZE(g.IO.KeysDown); i++)
+            g.IO.KeysDownDuration[i] = g.IO.KeysDown[i] ? (g.IO.KeysDownDuration[i] < 0.0f ? 0.0f : g.IO.KeysDownDuration[i] + g.IO.DeltaTime) : -1.0f;
+    }
 
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
@@ -2037,6 +2740,12 @@ void ImGui::NewFrame()
 void ImGui::Shutdown()
 {
     ImGuiState& g = *GImGui;
+    if (g.IO.InputEvents)
+    {
+        g.IO.MemFreeFn(g.IO.InputEvents);
+        g.IO.InputEvents = NULL;
+        g.IO.InputEventsSize = g.IO.InputEventsCapacity = 0;
+    }
     if (!g.Initialized)
         return;
 
@@ -2049,6 +2758,7 @@ void ImGui::Shutdown()
     }
     g.Windows.clear();
     g.WindowsSortBuffer.clear();
+    g.WindowsById.Clear();
     g.CurrentWindowStack.clear();
     g.FocusedWindow = NULL;
     g.HoveredWindow = NULL;
@@ -2056,6 +2766,7 @@ void ImGui::Shutdown()
     for (int i = 0; i < g.Settings.Size; i++)
         ImGui::MemFree(g.Settings[i].Name);
     g.Settings.clear();
+    g.SettingsIdxById.Clear();
     g.ColorModifiers.clear();
     g.StyleModifiers.clear();
     g.FontStack.clear();
@@ -2063,8 +2774,15 @@ void ImGui::Shutdown()
     g.CurrentPopupStack.clear();
     for (int i = 0; i < IM_ARRAYSIZE(g.RenderDrawLists); i++)
         g.RenderDrawLists[i].clear();
+    g.RenderDrawData.VtxBuffer.clear();
+    g.RenderDrawData.IdxBuffer.clear();
+    g.RenderDrawData.CmdListsVtxOffset.clear();
+    g.RenderDrawData.CmdListsIdxOffset.clear();
     g.OverlayDrawList.ClearFreeMemory();
     g.ColorEditModeStorage.Clear();
+    g.FrameArena.Clear();
+    g.KeysDownTracked.clear();
+    g.Tooltip = NULL;
     if (g.PrivateClipboard)
     {
         ImGui::MemFree(g.PrivateClipboard);
@@ -2095,21 +2813,19 @@ static ImGuiIniData* FindWindowSettings(const char* name)
 {
     ImGuiState& g = *GImGui;
     ImGuiID id = ImHash(name, 0);
-    for (int i = 0; i != g.Settings.Size; i++)
-    {
-        ImGuiIniData* ini = &g.Settings[i];
-        if (ini->ID == id)
-            return ini;
-    }
-    return NULL;
+    int idx = g.SettingsIdxById.GetInt(id, 0) - 1;
+    return (idx >= 0) ? &g.Settings[idx] : NULL;
 }
 
 static ImGuiIniData* AddWindowSettings(const char* name)
 {
-    GImGui->Settings.resize(GImGui->Settings.Size + 1);
-    ImGuiIniData* ini = &GImGui->Settings.back();
+    ImGuiState& g = *GImGui;
+    g.Settings.resize(g.Settings.Size + 1);
+    ImGuiIniData* ini = &g.Settings.back();
     ini->Name = ImStrdup(name);
     ini->ID = ImHash(name, 0);
+    if (g.SettingsIdxById.GetInt(ini->ID, 0) == 0)
+        g.SettingsIdxById.SetInt(ini->ID, g.Settings.Size);
     ini->Collapsed = false;
     ini->Pos = ImVec2(FLT_MAX,FLT_MAX);
     ini->Size = ImVec2(0,0);
@@ -2246,25 +2962,90 @@ static void AddWindowToSortedBuffer(ImVector<ImGuiWindow*>& out_sorted_windows,
 
 static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDrawList* draw_list)
 {
+    draw_list->CacheEnd();
+    GImGui->IO.MetricsCulledPrimitives += draw_list->_CulledCount;
     if (!draw_list->CmdBuffer.empty() && !draw_list->VtxBuffer.empty())
     {
         if (draw_list->CmdBuffer.back().ElemCount == 0)
             draw_list->CmdBuffer.pop_back();
+        if (GImGui->IO.OptimizeDrawCmds && draw_list->_CacheEntries.Size == 0) // The cache relies on the commands being left as they were built
+            GImGui->IO.MetricsRenderCmdsMerged += draw_list->OptimizeDrawCmds();
         out_render_list.push_back(draw_list);
 
         // Check that draw_list doesn't use more vertices than indexable (default ImDrawIdx = 2 bytes = 64K vertices)
-        // If this assert triggers because you are drawing lots of stuff manually, A) workaround by calling BeginChild()/EndChild() to put your draw commands in multiple draw lists, B) #define ImDrawIdx to a 'unsigned int' in imconfig.h and render accordingly.
+        // With 16-bit indices the list is split into commands with a different VtxOffset as it grows, so this can only trigger if a single primitive (e.g. a huge polyline or text) needs more than 64K vertices.
+        // If this assert triggers because you are drawing lots of stuff manually, A) split your primitives, B) #define ImDrawIdx to a 'unsigned int' in imconfig.h and render accordingly.
         const unsigned long long int max_vtx_idx = (unsigned long long int)1L << (sizeof(ImDrawIdx)*8);
         IM_ASSERT((unsigned long long int)draw_list->_VtxCurrentIdx <= max_vtx_idx);
 
         GImGui->IO.MetricsRenderVertices += draw_list->VtxBuffer.Size;
         GImGui->IO.MetricsRenderIndices += draw_list->IdxBuffer.Size;
+        GImGui->IO.MetricsRenderCmds += draw_list->CmdBuffer.Size;
     }
 }
 
+// Finish the draw lists of a window and its children (ending their cache, so the buffers hold this frame's content) and compute the area their triangles may touch.
+// Return false if the area is unknown because of a user callback.
+static bool CalcWindowDrawListsBounds(ImGuiWindow* window, ImRect& out_bb)
+{
+    for (int n = -1; n < window->UserDrawLists.Size; n++)
+    {
+        ImDrawList* draw_list = (n < 0) ? window->DrawList : window->UserDrawLists[n];
+        draw_list->CacheEnd();
+        ImRect clip_bb;
+        bool has_transform = false;
+        for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); pcmd++)
+        {
+            if (pcmd->UserCallback)
+                return false;
+            if (pcmd->ElemCount > 0)
+            {
+                clip_bb.Add(ImRect(pcmd->ClipRect));
+                has_transform |= (pcmd->Transform.x != 1.0f || pcmd->Transform.y != 1.0f || pcmd->Transform.z != 0.0f || pcmd->Transform.w != 0.0f);
+            }
+        }
+        if (clip_bb.Min.x > clip_bb.Max.x)
+            continue;
+        if (has_transform)
+        {
+            out_bb.Add(clip_bb);
+            continue;
+        }
+
+        // Root windows are clipped to the whole screen, so bound the vertices as well
+        ImRect vtx_bb;
+        for (const ImDrawVert* vtx = draw_list->VtxBuffer.begin(); vtx < draw_list->VtxBuffer.end(); vtx++)
+            vtx_bb.Add(ImDrawVertGetPos(*vtx));
+        vtx_bb.Clip(clip_bb);
+        out_bb.Add(vtx_bb);
+    }
+    for (int i = 0; i < window->DC.ChildWindows.Size; i++)
+    {
+        ImGuiWindow* child = window->DC.ChildWindows[i];
+        if (!child->Active)
+            continue;
+        if ((child->Flags & ImGuiWindowFlags_Popup) && child->HiddenFrames > 0)
+            continue;
+        if (!CalcWindowDrawListsBounds(child, out_bb))
+            return false;
+    }
+    return true;
+}
+
+static int GetWindowRenderLayer(ImGuiWindow* window)
+{
+    if (window->Flags & ImGuiWindowFlags_Popup)
+        return 1;
+    if (window->Flags & ImGuiWindowFlags_Tooltip)
+        return 2;
+    return 0;
+}
+
 static void AddWindowToRenderList(ImVector<ImDrawList*>& out_render_list, ImGuiWindow* window)
 {
     AddDrawListToRenderList(out_render_list, window->DrawList);
+    for (int i = 0; i < window->UserDrawLists.Size; i++)
+        AddDrawListToRenderList(out_render_list, window->UserDrawLists[i]);
     for (int i = 0; i < window->DC.ChildWindows.Size; i++)
     {
         ImGuiWindow* child = window->DC.ChildWindows[i];
@@ -2309,7 +3090,7 @@ void ImGui::EndFrame()
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // ImGui::EndFrame() called multiple times, or forgot to call ImGui::NewFrame() again
 
     // Render tooltip
-    if (g.Tooltip[0])
+    if (g.Tooltip && g.Tooltip[0])
     {
         ImGui::BeginTooltip();
         ImGui::TextUnformatted(g.Tooltip);
@@ -2365,6 +3146,8 @@ void ImGui::EndFrame()
     g.IO.MouseWheel = 0.0f;
     memset(g.IO.InputCharacters, 0, sizeof(g.IO.InputCharacters));
 
+    UpdateIdleState();
+
     g.FrameCountEnded = g.FrameCount;
 }
 
@@ -2382,9 +3165,42 @@ void ImGui::Render()
     if (g.Style.Alpha > 0.0f)
     {
         // Gather windows to render
-        g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsActiveWindows = 0;
+        g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsActiveWindows = g.IO.MetricsCulledPrimitives = 0;
+        g.IO.MetricsRenderCmds = g.IO.MetricsRenderCmdsMerged = g.IO.MetricsOccludedWindows = 0;
         for (int i = 0; i < IM_ARRAYSIZE(g.RenderDrawLists); i++)
             g.RenderDrawLists[i].resize(0);
+
+        // Occlusion culling: walk windows front to back, skip those entirely behind the opaque background of a window in front of them
+        // The 1 pixel margin covers the rounding of clipping rectangles to the scissor done by the renderer.
+        g.RenderOccluders.resize(0);
+        for (int layer = IM_ARRAYSIZE(g.RenderDrawLists)-1; layer >= 0; layer--)
+            for (int i = g.Windows.Size-1; i >= 0; i--)
+            {
+                ImGuiWindow* window = g.Windows[i];
+                if (!window->Active || window->HiddenFrames > 0 || (window->Flags & ImGuiWindowFlags_ChildWindow) || GetWindowRenderLayer(window) != layer)
+                    continue;
+                // Only look at the draw lists of windows whose rectangle is covered. Their contents almost never go past it, but CalcWindowDrawListsBounds() makes sure.
+                window->Occluded = false;
+                ImRect window_bb = window->Rect();
+                window_bb.Expand(1.0f);
+                for (int occluder_n = 0; occluder_n < g.RenderOccluders.Size; occluder_n++)
+                {
+                    const ImRect& occluder = g.RenderOccluders[occluder_n];
+                    if (occluder.Contains(window_bb))
+                    {
+                        ImRect bb;
+                        if (CalcWindowDrawListsBounds(window, bb) && bb.Min.x <= bb.Max.x)
+                        {
+                            bb.Expand(1.0f);
+                            window->Occluded = occluder.Contains(bb);
+                        }
+                        break;
+                    }
+                }
+                if (!window->Occluded && window->OpaqueRect.Min.x < window->OpaqueRect.Max.x && window->OpaqueRect.Min.y < window->OpaqueRect.Max.y)
+                    g.RenderOccluders.push_back(window->OpaqueRect);
+            }
+
         for (int i = 0; i != g.Windows.Size; i++)
         {
             ImGuiWindow* window = g.Windows[i];
@@ -2392,12 +3208,10 @@ void ImGui::Render()
             {
                 // FIXME: Generalize this with a proper layering system so e.g. user can draw in specific layers, below text, ..
                 g.IO.MetricsActiveWindows++;
-                if (window->Flags & ImGuiWindowFlags_Popup)
-                    AddWindowToRenderList(g.RenderDrawLists[1], window);
-                else if (window->Flags & ImGuiWindowFlags_Tooltip)
-                    AddWindowToRenderList(g.RenderDrawLists[2], window);
+                if (window->Occluded)
+                    g.IO.MetricsOccludedWindows++;
                 else
-                    AddWindowToRenderList(g.RenderDrawLists[0], window);
+                    AddWindowToRenderList(g.RenderDrawLists[GetWindowRenderLayer(window)], window);
             }
         }
 
@@ -2419,16 +3233,18 @@ void ImGui::Render()
         // Draw software mouse cursor if requested
         if (g.IO.MouseDrawCursor)
         {
-            const ImGuiMouseCursorData& cursor_data = g.MouseCursorData[g.MouseCursor];
-            const ImVec2 pos = g.IO.MousePos - cursor_data.HotOffset;
-            const ImVec2 size = cursor_data.Size;
-            const ImTextureID tex_id = g.IO.Fonts->TexID;
-            g.OverlayDrawList.PushTextureID(tex_id);
-            g.OverlayDrawList.AddImage(tex_id, pos+ImVec2(1,0), pos+ImVec2(1,0) + size, cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], 0x30000000); // Shadow
-            g.OverlayDrawList.AddImage(tex_id, pos+ImVec2(2,0), pos+ImVec2(2,0) + size, cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], 0x30000000); // Shadow
-            g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], 0xFF000000); // Black border
-            g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[0], cursor_data.TexUvMax[0], 0xFFFFFFFF); // White fill
-            g.OverlayDrawList.PopTextureID();
+            ImVec2 offset, size, uv_fill[2], uv_border[2];
+            if (g.IO.Fonts->GetMouseCursorTexData(g.MouseCursor, &offset, &size, uv_fill, uv_border))
+            {
+                const ImVec2 pos = g.IO.MousePos - offset;
+                const ImTextureID tex_id = g.IO.Fonts->TexID;
+                g.OverlayDrawList.PushTextureID(tex_id);
+                g.OverlayDrawList.AddImage(tex_id, pos+ImVec2(1,0), pos+ImVec2(1,0) + size, uv_border[0], uv_border[1], 0x30000000); // Shadow
+                g.OverlayDrawList.AddImage(tex_id, pos+ImVec2(2,0), pos+ImVec2(2,0) + size, uv_border[0], uv_border[1], 0x30000000); // Shadow
+                g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             uv_border[0], uv_border[1], 0xFF000000); // Black border
+                g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             uv_fill[0],   uv_fill[1],   0xFFFFFFFF); // White fill
+                g.OverlayDrawList.PopTextureID();
+            }
         }
         if (!g.OverlayDrawList.VtxBuffer.empty())
             AddDrawListToRenderList(g.RenderDrawLists[0], &g.OverlayDrawList);
@@ -3026,7 +3842,7 @@ ImVec2 ImGui::CalcItemRectClosestPoint(const ImVec2& pos, bool on_edge, float ou
 void ImGui::SetTooltipV(const char* fmt, va_list args)
 {
     ImGuiState& g = *GImGui;
-    ImFormatStringV(g.Tooltip, IM_ARRAYSIZE(g.Tooltip), fmt, args);
+    g.Tooltip = g.FrameArena.FormatV(fmt, args);
 }
 
 void ImGui::SetTooltip(const char* fmt, ...)
@@ -3388,13 +4204,9 @@ static ImVec2 FindBestPopupWindowPos(const ImVec2& base_pos, const ImVec2& size,
 
 static ImGuiWindow* FindWindowByName(const char* name)
 {
-    // FIXME-OPT: Store sorted hashes -> pointers.
     ImGuiState& g = *GImGui;
     ImGuiID id = ImHash(name, 0);
-    for (int i = 0; i < g.Windows.Size; i++)
-        if (g.Windows[i]->ID == id)
-            return g.Windows[i];
-    return NULL;
+    return (ImGuiWindow*)g.WindowsById.GetVoidPtr(id);
 }
 
 static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags)
@@ -3457,6 +4269,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
     }
 
     g.Windows.push_back(window);
+    g.WindowsById.SetVoidPtr(window->ID, window);
     return window;
 }
 
@@ -3586,8 +4399,13 @@ bool ImGui::Begin(const char* name, bool* p_opened, const ImVec2& size_on_first_
     {
         window->Active = true;
         window->BeginCount = 0;
-        window->DrawList->Clear();
+        if (flags & ImGuiWindowFlags_CachedDrawList)
+            window->DrawList->CacheBegin();
+        else
+            window->DrawList->Clear();
+        window->UserDrawLists.resize(0);
         window->ClipRect = ImVec4(-FLT_MAX,-FLT_MAX,+FLT_MAX,+FLT_MAX);
+        window->OpaqueRect = ImRect(0.0f, 0.0f, 0.0f, 0.0f);
         window->LastFrameDrawn = current_frame;
         window->IDStack.resize(1);
 
@@ -3881,16 +4699,25 @@ bool ImGui::Begin(const char* name, bool* p_opened, const ImVec2& size_on_first_
             // Window background
             if (bg_alpha > 0.0f)
             {
+                ImU32 bg_col;
                 if ((flags & ImGuiWindowFlags_ComboBox) != 0)
-                    window->DrawList->AddRectFilled(window->Pos, window->Pos+window->Size, window->Color(ImGuiCol_ComboBg, bg_alpha), window_rounding);
+                    bg_col = window->Color(ImGuiCol_ComboBg, bg_alpha);
                 else if ((flags & ImGuiWindowFlags_Tooltip) != 0)
-                    window->DrawList->AddRectFilled(window->Pos, window->Pos+window->Size, window->Color(ImGuiCol_TooltipBg, bg_alpha), window_rounding);
+                    bg_col = window->Color(ImGuiCol_TooltipBg, bg_alpha);
                 else if ((flags & ImGuiWindowFlags_Popup) != 0)
-                    window->DrawList->AddRectFilled(window->Pos, window->Pos+window->Size, window->Color(ImGuiCol_WindowBg, bg_alpha), window_rounding);
+                    bg_col = window->Color(ImGuiCol_WindowBg, bg_alpha);
                 else if ((flags & ImGuiWindowFlags_ChildWindow) != 0)
-                    window->DrawList->AddRectFilled(window->Pos, window->Pos+window->Size, window->Color(ImGuiCol_ChildWindowBg, bg_alpha), window_rounding);
+                    bg_col = window->Color(ImGuiCol_ChildWindowBg, bg_alpha);
                 else
-                    window->DrawList->AddRectFilled(window->Pos, window->Pos+window->Size, window->Color(ImGuiCol_WindowBg, bg_alpha), window_rounding);
+                    bg_col = window->Color(ImGuiCol_WindowBg, bg_alpha);
+                window->DrawList->AddRectFilled(window->Pos, window->Pos+window->Size, bg_col, window_rounding);
+
+                // An opaque, square background hides everything behind it. Child windows are ignored as their rectangle may extend past what their parent shows.
+                if ((bg_col >> 24) == 0xFF && window_rounding <= 0.0f && !(flags & ImGuiWindowFlags_ChildWindow))
+                {
+                    window->OpaqueRect = window->Rect();
+                    window->OpaqueRect.Clip(window->ClipRect);
+                }
             }
 
             // Title bar
@@ -4247,7 +5074,9 @@ static void SetCurrentFont(ImFont* font)
     g.Font = font;
     g.FontBaseSize = g.IO.FontGlobalScale * g.Font->FontSize * g.Font->Scale;
     g.FontSize = g.CurrentWindow ? g.CurrentWindow->CalcFontSize() : 0.0f;
-    g.FontTexUvWhitePixel = g.Font->ContainerAtlas->TexUvWhitePixel;
+    g.DrawListSharedData.Font = g.Font;
+    g.DrawListSharedData.FontSize = g.FontSize;
+    g.DrawListSharedData.TexUvWhitePixel = g.Font->ContainerAtlas->TexUvWhitePixel;
 }
 
 void ImGui::PushFont(ImFont* font)
@@ -4744,6 +5573,18 @@ ImDrawList* ImGui::GetWindowDrawList()
     return window->DrawList;
 }
 
+void ImGui::AddWindowDrawList(ImDrawList* draw_list)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    IM_ASSERT(draw_list != NULL && draw_list != window->DrawList);
+    window->UserDrawLists.push_back(draw_list);
+}
+
+const ImDrawListSharedData* ImGui::GetDrawListSharedData()
+{
+    return &GImGui->DrawListSharedData;
+}
+
 ImFont* ImGui::GetWindowFont()
 {
     ImGuiState& g = *GImGui;
@@ -4761,7 +5602,7 @@ void ImGui::SetWindowFontScale(float scale)
     ImGuiState& g = *GImGui;
     ImGuiWindow* window = GetCurrentWindow();
     window->FontWindowScale = scale;
-    g.FontSize = window->CalcFontSize();
+    g.FontSize = g.DrawListSharedData.FontSize = window->CalcFontSize();
 }
 
 // User generally sees positions in window coordinates. Internally we store CursorPos in absolute screen coordinates because it is more convenient.
@@ -4904,8 +5745,10 @@ void ImGui::TextV(const char* fmt, va_list args)
         return;
 
     ImGuiState& g = *GImGui;
-    const char* text_end = g.TempBuffer + ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
-    TextUnformatted(g.TempBuffer, text_end);
+    const char* text_end;
+    char* text_begin = g.FrameArena.FormatV(fmt, args, &text_end);
+    TextUnformatted(text_begin, text_end);
+    g.FrameArena.Free(text_begin);
 }
 
 void ImGui::Text(const char* fmt, ...)
@@ -5099,9 +5942,10 @@ void ImGui::LabelTextV(const char* label, const char* fmt, va_list args)
         return;
 
     // Render
-    const char* value_text_begin = &g.TempBuffer[0];
-    const char* value_text_end = value_text_begin + ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    const char* value_text_end;
+    char* value_text_begin = g.FrameArena.FormatV(fmt, args, &value_text_end);
     RenderTextClipped(value_bb.Min, value_bb.Max, value_text_begin, value_text_end, NULL, ImGuiAlign_VCenter);
+    g.FrameArena.Free(value_text_begin);
     RenderText(ImVec2(value_bb.Max.x + style.ItemInnerSpacing.x, value_bb.Min.y + style.FramePadding.y), label);
 }
 
@@ -5628,19 +6472,20 @@ void ImGui::BulletTextV(const char* fmt, va_list args)
     ImGuiState& g = *GImGui;
     const ImGuiStyle& style = g.Style;
 
-    const char* text_begin = g.TempBuffer;
-    const char* text_end = text_begin + ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    const char* text_end;
+    char* text_begin = g.FrameArena.FormatV(fmt, args, &text_end);
     const float line_height = g.FontSize;
     const ImVec2 label_size = CalcTextSize(text_begin, text_end, true);
     const ImRect bb(window->DC.CursorPos, window->DC.CursorPos + ImVec2(line_height + (label_size.x > 0.0f ? (style.FramePadding.x*2) : 0.0f),0) + label_size);  // Empty text doesn't add padding
     ItemSize(bb);
-    if (!ItemAdd(bb, NULL))
-        return;
-
-    // Render
-    const float bullet_size = line_height*0.15f;
-    window->DrawList->AddCircleFilled(bb.Min + ImVec2(style.FramePadding.x + line_height*0.5f, line_height*0.5f), bullet_size, window->Color(ImGuiCol_Text));
-    RenderText(bb.Min+ImVec2(g.FontSize + style.FramePadding.x*2,0), text_begin, text_end);
+    if (ItemAdd(bb, NULL))
+    {
+        // Render
+        const float bullet_size = line_height*0.15f;
+        window->DrawList->AddCircleFilled(bb.Min + ImVec2(style.FramePadding.x + line_height*0.5f, line_height*0.5f), bullet_size, window->Color(ImGuiCol_Text));
+        RenderText(bb.Min+ImVec2(g.FontSize + style.FramePadding.x*2,0), text_begin, text_end);
+    }
+    g.FrameArena.Free(text_begin);
 }
 
 void ImGui::BulletText(const char* fmt, ...)
@@ -5659,13 +6504,14 @@ bool ImGui::TreeNodeV(const char* str_id, const char* fmt, va_list args)
         return false;
 
     ImGuiState& g = *GImGui;
-    ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    char* label = g.FrameArena.FormatV(fmt, args);
     if (!str_id || !str_id[0])
         str_id = fmt;
 
     ImGui::PushID(str_id);
-    const bool opened = ImGui::CollapsingHeader(g.TempBuffer, "", false);
+    const bool opened = ImGui::CollapsingHeader(label, "", false);
     ImGui::PopID();
+    g.FrameArena.Free(label);
 
     if (opened)
         ImGui::TreePush(str_id);
@@ -5690,14 +6536,15 @@ bool ImGui::TreeNodeV(const void* ptr_id, const char* fmt, va_list args)
         return false;
 
     ImGuiState& g = *GImGui;
-    ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    char* label = g.FrameArena.FormatV(fmt, args);
 
     if (!ptr_id)
         ptr_id = fmt;
 
     ImGui::PushID(ptr_id);
-    const bool opened = ImGui::CollapsingHeader(g.TempBuffer, "", false);
+    const bool opened = ImGui::CollapsingHeader(label, "", false);
     ImGui::PopID();
+    g.FrameArena.Free(label);
 
     if (opened)
         ImGui::TreePush(ptr_id);
@@ -5751,6 +6598,14 @@ void ImGui::PushID(int int_id)
     window->IDStack.push_back(window->GetID(ptr_id));
 }
 
+#ifdef IMGUI_USE_CONSTEXPR_ID
+void ImGui::PushID(ImGuiIdHash id_hash)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    window->IDStack.push_back(window->GetID(id_hash));
+}
+#endif
+
 void ImGui::PopID()
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -5772,6 +6627,13 @@ ImGuiID ImGui::GetID(const void* ptr_id)
     return GImGui->CurrentWindow->GetID(ptr_id);
 }
 
+#ifdef IMGUI_USE_CONSTEXPR_ID
+ImGuiID ImGui::GetID(ImGuiIdHash id_hash)
+{
+    return GImGui->CurrentWindow->GetID(id_hash);
+}
+#endif
+
 static inline void DataTypeFormatString(ImGuiDataType data_type, void* data_ptr, const char* display_format, char* buf, int buf_size)
 {
     if (data_type == ImGuiDataType_Int)
@@ -9075,6 +9937,23 @@ void ImGui::ShowMetricsWindow(bool* opened)
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
         ImGui::Text("%d allocations", ImGui::GetIO().MetricsAllocs);
+        ImGui::Text("Frame arena: %d/%d bytes used", GImGui->FrameArena.GetUsedSize(), GImGui->FrameArena.GetCapacity());
+        int cache_hits = 0, cache_misses = 0, cache_bytes_saved = 0;
+        for (int i = 0; i < GImGui->Windows.Size; i++)
+        {
+            const ImDrawList* draw_list = GImGui->Windows[i]->DrawList;
+            cache_hits += draw_list->_CacheHits;
+            cache_misses += draw_list->_CacheMisses;
+            cache_bytes_saved += draw_list->_CacheBytesSaved;
+        }
+        if (cache_hits + cache_misses > 0)
+            ImGui::Text("Cached draw lists: %.1f%% hit rate (%d/%d), %d bytes reused", 100.0f * cache_hits / (cache_hits + cache_misses), cache_hits, cache_hits + cache_misses, cache_bytes_saved);
+        if (ImGui::GetIO().MetricsCulledPrimitives > 0)
+            ImGui::Text("%d primitives culled on CPU", ImGui::GetIO().MetricsCulledPrimitives);
+        if (ImGui::GetIO().MetricsOccludedWindows > 0)
+            ImGui::Text("%d windows hidden behind opaque windows", ImGui::GetIO().MetricsOccludedWindows);
+        if (ImGui::GetIO().OptimizeDrawCmds)
+            ImGui::Text("%d draw commands (%d removed by io.OptimizeDrawCmds)", ImGui::GetIO().MetricsRenderCmds, ImGui::GetIO().MetricsRenderCmdsMerged);
         static bool show_clip_rects = true;
         ImGui::Checkbox("Show clipping rectangles when hovering a ImDrawCmd", &show_clip_rects);
         ImGui::Separator();
@@ -9084,6 +9963,11 @@ void ImGui::ShowMetricsWindow(bool* opened)
             static void NodeDrawList(ImDrawList* draw_list, const char* label)
             {
                 bool node_opened = ImGui::TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->CmdBuffer.Size);
+                if (draw_list->CpuCulling)
+                {
+                    ImGui::SameLine();
+                    ImGui::Text("(%d culled)", draw_list->_CulledCount);
+                }
                 if (draw_list == ImGui::GetWindowDrawList())
                 {
                     ImGui::SameLine();
@@ -9092,8 +9976,7 @@ void ImGui::ShowMetricsWindow(bool* opened)
                 if (!node_opened)
                     return;
 
-                int elem_offset = 0;
-                for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); elem_offset += pcmd->ElemCount, pcmd++)
+                for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); pcmd++)
                 {
                     if (pcmd->UserCallback)
                         ImGui::BulletText("Callback %p, user_data %p", pcmd->UserCallback, pcmd->UserCallbackData);
@@ -9104,8 +9987,9 @@ void ImGui::ShowMetricsWindow(bool* opened)
                         {
                             ImRect clip_rect = pcmd->ClipRect;
                             ImRect vtxs_rect;
-                            for (int i = elem_offset; i < elem_offset + (int)pcmd->ElemCount; i++)
-                                vtxs_rect.Add(draw_list->VtxBuffer[draw_list->IdxBuffer[i]].pos);
+                            for (int i = (int)pcmd->IdxOffset; i < (int)(pcmd->IdxOffset + pcmd->ElemCount); i++)
+                                vtxs_rect.Add(ImDrawVertGetPos(draw_list->VtxBuffer[pcmd->VtxOffset + draw_list->IdxBuffer[i]]));
+                            vtxs_rect = ImDrawCmdTransformRect(pcmd->Transform, vtxs_rect);
                             GImGui->OverlayDrawList.PushClipRectFullScreen();
                             clip_rect.Round(); GImGui->OverlayDrawList.AddRect(clip_rect.Min, clip_rect.Max, ImColor(255,255,0));
                             vtxs_rect.Round(); GImGui->OverlayDrawList.AddRect(vtxs_rect.Min, vtxs_rect.Max, ImColor(255,0,255));
@@ -39,10 +39,13 @@
 // Forward declarations
 struct ImDrawCmd;
 struct ImDrawList;
+struct ImDrawListSharedData;
 struct ImDrawData;
 struct ImFont;
 struct ImFontAtlas;
 struct ImGuiIO;
+struct ImGuiInputEvent;
+struct ImGuiState;                  // Context, opaque outside of imgui_internal.h
 struct ImGuiStorage;
 struct ImGuiStyle;
 
@@ -53,6 +56,7 @@ typedef ImU32 ImGuiID;              // unique ID used by widgets (typically hash
 typedef int ImGuiCol;               // enum ImGuiCol_
 typedef int ImGuiStyleVar;          // enum ImGuiStyleVar_
 typedef int ImGuiKey;               // enum ImGuiKey_
+typedef int ImGuiInputEventType;    // enum ImGuiInputEventType_
 typedef int ImGuiAlign;             // enum ImGuiAlign_
 typedef int ImGuiColorEditMode;     // enum ImGuiColorEditMode_
 typedef int ImGuiMouseCursor;       // enum ImGuiMouseCursor_
@@ -85,6 +89,25 @@ struct ImVec4
 #endif
 };
 
+#ifdef IMGUI_USE_CONSTEXPR_ID
+// Seed-less hash of a string, computed at compile time when passed a literal via IMGUI_ID() (requires C++11 constexpr). Enable with IMGUI_USE_CONSTEXPR_ID in imconfig.h.
+// Pass to GetID()/PushID() which combine it with the current ID stack at runtime: PushID(IMGUI_ID("row")), GetID(IMGUI_ID("Apply")).
+// NB: the resulting IDs are different from those of GetID("Apply")/PushID("row"), so don't mix both forms for a same item. Like ImHash(), only the part after the last "###" is hashed.
+struct ImGuiIdHash
+{
+    ImU32 Value;
+    constexpr explicit ImGuiIdHash(ImU32 value) : Value(value) {}
+
+    // FNV-1a, restarting on "###". Written as a single recursive expression to satisfy C++11 constexpr rules.
+    static constexpr ImU32 HashStr(const char* str, ImU32 hash = 2166136261u)
+    {
+        return !*str ? hash : (str[0] == '#' && str[1] == '#' && str[2] == '#') ? HashStr(str + 1, (2166136261u ^ (ImU32)'#') * 16777619u) : HashStr(str + 1, (hash ^ (ImU32)(unsigned char)*str) * 16777619u);
+    }
+};
+template<ImU32 HASH> struct ImGuiIdHashConstant { static const ImU32 Value = HASH; };
+#define IMGUI_ID(_LITERAL)  ImGuiIdHash(ImGuiIdHashConstant<ImGuiIdHash::HashStr(_LITERAL)>::Value)   // Force evaluation at compile time
+#endif
+
 // Helpers at bottom of the file:
 // - class ImVector<>                   // Lightweight std::vector like class.
 // - IMGUI_ONCE_UPON_A_FRAME            // Execute a block of code once per frame only (convenient for creating UI within deep-nested code that runs multiple times)
@@ -128,6 +151,8 @@ namespace ImGui
     IMGUI_API ImVec2        GetWindowContentRegionMax();                                        // content boundaries max (roughly (0,0)+Size-Scroll) where Size can be override with SetNextWindowContentSize(), in window coordinates
     IMGUI_API float         GetWindowContentRegionWidth();                                      // 
     IMGUI_API ImDrawList*   GetWindowDrawList();                                                // get rendering command-list if you want to append your own draw primitives
+    IMGUI_API void          AddWindowDrawList(ImDrawList* draw_list);                           // render a draw list you built yourself (possibly on another thread) right after the current window's own draw list. it is only read in Render(), so it must be complete and stay alive until then
+    IMGUI_API const ImDrawListSharedData* GetDrawListSharedData();                              // fonts, white pixel UV and tessellation settings used by the draw lists of the current context. copy it to build an ImDrawList on another thread, the context modifies it while building windows
     IMGUI_API ImFont*       GetWindowFont();
     IMGUI_API float         GetWindowFontSize();                                                // size (also height in pixels) of current font with current scale applied
     IMGUI_API void          SetWindowFontScale(float scale);                                    // per-window font scale. Adjust IO.FontGlobalScale if you want to scale all windows
@@ -222,10 +247,16 @@ namespace ImGui
     IMGUI_API void          PushID(const char* str_id_begin, const char* str_id_end);
     IMGUI_API void          PushID(const void* ptr_id);
     IMGUI_API void          PushID(int int_id);
+#ifdef IMGUI_USE_CONSTEXPR_ID
+    IMGUI_API void          PushID(ImGuiIdHash id_hash);                                        // e.g. PushID(IMGUI_ID("row")) to avoid hashing a literal at runtime
+#endif
     IMGUI_API void          PopID();
     IMGUI_API ImGuiID       GetID(const char* str_id);                                          // calculate unique ID (hash of whole ID stack + given parameter). useful if you want to query into ImGuiStorage yourself. otherwise rarely needed
     IMGUI_API ImGuiID       GetID(const char* str_id_begin, const char* str_id_end);
     IMGUI_API ImGuiID       GetID(const void* ptr_id);
+#ifdef IMGUI_USE_CONSTEXPR_ID
+    IMGUI_API ImGuiID       GetID(ImGuiIdHash id_hash);
+#endif
 
     // Widgets
     IMGUI_API void          Text(const char* fmt, ...) IM_PRINTFARGS(1);
@@ -415,6 +446,7 @@ namespace ImGui
     IMGUI_API void          SetMouseCursor(ImGuiMouseCursor type);                              // set desired cursor type
     IMGUI_API void          CaptureKeyboardFromApp();                                           // manually enforce imgui setting the io.WantCaptureKeyboard flag next frame (your application needs to handle it). e.g. capture keyboard when your widget is being hovered.
     IMGUI_API void          CaptureMouseFromApp();                                              // manually enforce imgui setting the io.WantCaptureMouse flag next frame (your application needs to handle it).
+    IMGUI_API bool          IsNewFrameNeeded(float elapsed_time);                               // idle detection: call after filling io inputs, passing the time since the last NewFrame(). when false, ImGui output would be identical: you can skip NewFrame()/Render() and present the last GetDrawData() again. changes in your own data are your responsibility.
 
     // Helpers functions to access functions pointers in ImGui::GetIO()
     IMGUI_API void*         MemAlloc(size_t sz);
@@ -427,6 +459,10 @@ namespace ImGui
     IMGUI_API void*         GetInternalState();
     IMGUI_API size_t        GetInternalStateSize();
     IMGUI_API void          SetInternalState(void* state, bool construct = false);
+    IMGUI_API ImGuiState*   CreateContext(void* (*malloc_fn)(size_t) = NULL, void (*free_fn)(void*) = NULL);    // create an independent context (its own windows, settings, input and draw data). doesn't change the current context. io.IniFilename defaults to NULL, set a different file per context.
+    IMGUI_API void          DestroyContext(ImGuiState* ctx);                                    // shutdown and free a context created with CreateContext(). doesn't clear io.Fonts which may be shared.
+    IMGUI_API ImGuiState*   GetCurrentContext();
+    IMGUI_API void          SetCurrentContext(ImGuiState* ctx);                                 // NULL selects the default context. define IMGUI_USE_THREAD_LOCAL_CONTEXT in imconfig.h to have a current context per thread.
 
     // Obsolete (will be removed)
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
@@ -461,6 +497,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_HorizontalScrollbar    = 1 << 11,  // Enable horizontal scrollbar (off by default). You need to use SetNextWindowContentSize(ImVec2(width,0.0f)); prior to calling Begin() to specify width. Read code in imgui_demo in the "Horizontal Scrolling" section.
     ImGuiWindowFlags_NoFocusOnAppearing     = 1 << 12,  // Disable taking focus when transitioning from hidden to visible state
     ImGuiWindowFlags_NoBringToFrontOnFocus  = 1 << 13,  // Disable bringing window to front when taking focus (e.g. clicking on it or programatically giving it focus)
+    ImGuiWindowFlags_CachedDrawList         = 1 << 14,  // Reuse last frame's vertices/indices when the window emits the same primitives again (your code still runs, but matching primitives are hashed instead of tessellated)
     // [Internal]
     ImGuiWindowFlags_ChildWindow            = 1 << 20,  // Don't use! For internal use by BeginChild()
     ImGuiWindowFlags_ChildWindowAutoFitX    = 1 << 21,  // Don't use! For internal use by BeginChild()
@@ -528,6 +565,17 @@ enum ImGuiKey_
     ImGuiKey_COUNT
 };
 
+// Types of ImGuiInputEvent, queued with ImGuiIO::AddKeyEvent() etc.
+enum ImGuiInputEventType_
+{
+    ImGuiInputEventType_MousePos,
+    ImGuiInputEventType_MouseButton,
+    ImGuiInputEventType_MouseWheel,
+    ImGuiInputEventType_Key,
+    ImGuiInputEventType_KeyMods,
+    ImGuiInputEventType_Char
+};
+
 // Enumeration for PushStyleColor() / PopStyleColor()
 enum ImGuiCol_
 {
@@ -661,7 +709,7 @@ struct ImGuiStyle
     ImVec2      DisplaySafeAreaPadding;     // If you cannot see the edge of your screen (e.g. on a TV) increase the safe area padding. Covers popups/tooltips as well regular windows.
     bool        AntiAliasedLines;           // Enable anti-aliasing on lines/borders. Disable if you are really tight on CPU/GPU.
     bool        AntiAliasedShapes;          // Enable anti-aliasing on filled shapes (rounded rectangles, circles, etc.)
-    float       CurveTessellationTol;       // Tessellation tolerance. Decrease for highly tessellated curves (higher quality, more polygons), increase to reduce quality.
+    float       CurveTessellationTol;       // Tessellation tolerance for Bezier curves, circles and rounded corners. Decrease for highly tessellated curves (higher quality, more polygons), increase to reduce quality.
     ImVec4      Colors[ImGuiCol_COUNT];
 
     IMGUI_API ImGuiStyle();
@@ -689,6 +737,7 @@ struct ImGuiIO
     void*         UserData;                 // = NULL               // Store your own data for retrieval by callbacks.
 
     ImFontAtlas*  Fonts;                    // <auto>               // Load and assemble one or more fonts into a single tightly packed texture. Output to Fonts array.
+    bool          OptimizeDrawCmds;         // = false              // Call ImDrawList::OptimizeDrawCmds() on every draw list in Render(), trading some CPU time for fewer draw calls. Lists using ImGuiWindowFlags_CachedDrawList are left alone.
     float         FontGlobalScale;          // = 1.0f               // Global scale all fonts
     bool          FontAllowUserScaling;     // = false              // Allow user scaling text of individual window with CTRL+Wheel.
     ImVec2        DisplayFramebufferScale;  // = (1.0f,1.0f)        // For retina display or other situations where window coordinates are different from framebuffer coordinates. User storage only, presently not used by ImGui.
@@ -737,6 +786,18 @@ struct ImGuiIO
     IMGUI_API void AddInputCharacter(ImWchar c);                    // Helper to add a new character into InputCharacters[]
     IMGUI_API void AddInputCharactersUTF8(const char* utf8_chars);  // Helper to add new characters into InputCharacters[] from an UTF-8 string
 
+    // Input events queue: an alternative to filling the fields above, which can be called from any thread at any time (e.g. from your OS event callbacks).
+    // Events are applied in order by NewFrame(). When a same key or mouse button changes more than once before a frame, or more characters than InputCharacters[] can hold arrive, the remaining events are kept for the following frames so no click or character is lost.
+    // 'time' is an optional timestamp in seconds from your own clock (use the same clock for all events). When two clicks both have one, it is used for double-click detection instead of frame time.
+    // Once you use AddKeyEvent(), don't write to KeysDown[] directly.
+    IMGUI_API void AddMousePosEvent(float x, float y, double time = -1.0);
+    IMGUI_API void AddMouseButtonEvent(int button, bool down, double time = -1.0);
+    IMGUI_API void AddMouseWheelEvent(float wheel, double time = -1.0);
+    IMGUI_API void AddKeyEvent(int key_index, bool down, double time = -1.0);
+    IMGUI_API void AddKeyModsEvent(bool ctrl, bool shift, bool alt, double time = -1.0);
+    IMGUI_API void AddCharEvent(ImWchar c, double time = -1.0);
+    IMGUI_API void AddInputEvent(const ImGuiInputEvent& e);
+
     //------------------------------------------------------------------
     // Output - Retrieve after calling NewFrame(), you can use them to discard inputs or hide them from the rest of your application
     //------------------------------------------------------------------
@@ -748,7 +809,13 @@ struct ImGuiIO
     int         MetricsAllocs;              // Number of active memory allocations
     int         MetricsRenderVertices;      // Vertices output during last call to Render()
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderCmds;          // Draw commands output during last call to Render()
+    int         MetricsRenderCmdsMerged;    // Draw commands removed by io.OptimizeDrawCmds during last call to Render() (MetricsRenderCmds + MetricsRenderCmdsMerged before optimizing)
     int         MetricsActiveWindows;       // Number of visible windows (exclude child windows)
+    int         MetricsOccludedWindows;     // Number of visible windows not rendered during last call to Render() because an opaque window fully covers them (included in MetricsActiveWindows)
+    int         MetricsCulledPrimitives;    // Primitives skipped during the last frame by draw lists with CpuCulling enabled
+    bool        WantRedraw;                 // Idle detection, set at the end of the frame: a new frame is needed even without new inputs (widget active, button/key held, animation, layout settling). See ImGui::IsNewFrameNeeded().
+    float       RedrawDelay;                // Idle detection, set at the end of the frame: otherwise time in seconds after which a new frame is needed even without new inputs (text cursor blink, pending .ini saving). FLT_MAX if none.
 
     //------------------------------------------------------------------
     // [Internal] ImGui will maintain those fields for you
@@ -767,10 +834,24 @@ struct ImGuiIO
     float       MouseDragMaxDistanceSqr[5]; // Squared maximum distance of how much mouse has traveled from the click point
     float       KeysDownDuration[512];      // Duration the keyboard key has been down (0.0f == just pressed)
     float       KeysDownDurationPrev[512];  // Previous duration the key has been down
+    ImGuiInputEvent* InputEvents;           // Queued input events, allocated with MemAllocFn/MemFreeFn. Protected by InputEventsLock.
+    int         InputEventsSize;
+    int         InputEventsCapacity;
+    volatile long InputEventsLock;
 
     IMGUI_API   ImGuiIO();
 };
 
+// Input event, see ImGuiIO::AddKeyEvent() etc.
+struct ImGuiInputEvent
+{
+    ImGuiInputEventType Type;
+    int         Index;                      // Mouse button, key index, character, or modifiers for KeyMods (1: Ctrl, 2: Shift, 4: Alt)
+    bool        Down;                       // Mouse button or key state
+    float       X, Y;                       // Mouse position, mouse wheel in X
+    double      Time;                       // Timestamp in seconds from your clock, -1.0 if unknown
+};
+
 //-----------------------------------------------------------------------------
 // Helpers
 //-----------------------------------------------------------------------------
@@ -913,10 +994,17 @@ struct ImGuiStorage
         Pair(ImGuiID _key, void* _val_p) { key = _key; val_p = _val_p; }
     };
     ImVector<Pair>    Data;
+#ifdef IMGUI_STORAGE_USE_HASH_TABLE
+    // Open-addressing mode (see imconfig.h): Data[] is a linear probing table of Data.Size-1 slots (power of two) where key 0 marks an empty slot,
+    // followed by one extra slot reserved for the key 0 itself. Data[] is unordered and contains empty slots.
+    int               DataCount;        // Number of pairs stored
+    bool              ZeroKeyUsed;      // Is the last slot of Data[] storing a pair with key 0?
+    ImGuiStorage()    { DataCount = 0; ZeroKeyUsed = false; }
+#endif
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N). With IMGUI_STORAGE_USE_HASH_TABLE a query is O(1).
     // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly but should amortize. A typical frame shouldn't need to insert any new pair.
+    // - Sorted insertion is costly but should amortize. A typical frame shouldn't need to insert any new pair. With IMGUI_STORAGE_USE_HASH_TABLE insertion is amortized O(1).
     IMGUI_API void    Clear();
     IMGUI_API int     GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void    SetInt(ImGuiID key, int val);
@@ -1037,22 +1125,56 @@ struct ImDrawCmd
     ImTextureID     TextureId;              // User-provided texture ID. Set by user in ImfontAtlas::SetTexID() for fonts or passed to Image*() functions. Ignore if never using images or multiple fonts atlas.
     ImDrawCallback  UserCallback;           // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;       // The draw callback code can access this.
+    unsigned int    VtxOffset;              // Start offset in vtx_buffer[] to add to the indices of this command. Non-zero when a list holds more vertices than ImDrawIdx can address (it is then split into several commands).
+    unsigned int    IdxOffset;              // Start offset in idx_buffer[] of the indices of this command. Always use it rather than summing ElemCount: after merging channels, idx_buffer[] may contain unused ranges and commands aren't necessarily in increasing IdxOffset order.
+    ImVec4          Transform;              // Transform to apply to the vertices positions (scale_x, scale_y, translate_x, translate_y): screen_pos = pos * scale + translate. Identity (1, 1, 0, 0) unless ImDrawList::PushTransform() was used. ClipRect is already in screen space.
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    ImTextureID     TextureIds[IMGUI_DRAWCMD_TEXTURE_SLOTS]; // Textures sampled by this command, ImDrawVert::tex is an index in this array. TextureIds[0] == TextureId.
+    int             TextureIdsCount;        // Number of used entries in TextureIds[] (1+)
+#endif
 
-    ImDrawCmd() { ElemCount = 0; ClipRect.x = ClipRect.y = -8192.0f; ClipRect.z = ClipRect.w = +8192.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; }
+    ImDrawCmd()
+    {
+        ElemCount = 0; ClipRect.x = ClipRect.y = -8192.0f; ClipRect.z = ClipRect.w = +8192.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; VtxOffset = IdxOffset = 0;
+        Transform.x = Transform.y = 1.0f; Transform.z = Transform.w = 0.0f;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+        TextureIds[0] = NULL; TextureIdsCount = 1;
+#endif
+    }
 };
 
 // Vertex index (override with, e.g. '#define ImDrawIdx unsigned int' in ImConfig)
+// With 16-bit indices, a draw list holding more than 64K vertices is split into commands using a different ImDrawCmd::VtxOffset.
 #ifndef ImDrawIdx
 typedef unsigned short ImDrawIdx;
 #endif
 
 // Vertex layout
-#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+// With IMGUI_DRAWCMD_TEXTURE_SLOTS defined in imconfig.h, vertices also store in 'tex' which of ImDrawCmd::TextureIds[] to sample. Your renderer needs to bind all of them and select one per vertex (e.g. a texture array, or a sampler array indexed in the pixel shader).
+// If you override the layout, add a 'tex' field as well: it is written by PrimReserve() and left alone by the code writing the other fields.
+#if defined(IMGUI_USE_COMPACT_DRAWVERT)
+// Compact 12 bytes layout, enabled by defining IMGUI_USE_COMPACT_DRAWVERT in imconfig.h. Your renderer needs to:
+// - read 'pos' as two signed 16-bit integers and divide them by IM_DRAWVERT_POS_SCALE (e.g. fold it into the projection matrix). Positions are clamped to -8192..+8192 pixels.
+// - read 'uv' as two normalized unsigned 16-bit integers (0..65535 maps to 0.0f..1.0f). Texture coordinates are clamped to 0.0f..1.0f, so Image() can't be used to repeat a texture.
+#define IM_DRAWVERT_POS_SCALE   4.0f    // Positions are stored in quarters of a pixel
+struct ImDrawVert
+{
+    short           pos[2];
+    unsigned short  uv[2];
+    ImU32           col;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    ImU32           tex;
+#endif
+};
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImDrawVert
 {
     ImVec2  pos;
     ImVec2  uv;
     ImU32   col;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    ImU32   tex;
+#endif
 };
 #else
 // You can change the vertex format layout by defining IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT in imconfig.h
@@ -1061,12 +1183,81 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// All vertices are written and read back through those, so the tessellation code doesn't depend on the vertex layout
+#if defined(IMGUI_USE_COMPACT_DRAWVERT)
+// Offset by 32768 and truncated, so that each value is rounded the same way by the SIMD and scalar versions
+#if !defined(IMGUI_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+static inline void          ImDrawVertWrite(ImDrawVert* vtx, const ImVec2& pos, const ImVec2& uv, ImU32 col)
+{
+    __m128 v = _mm_add_ps(_mm_mul_ps(_mm_setr_ps(pos.x, pos.y, uv.x, uv.y), _mm_setr_ps(IM_DRAWVERT_POS_SCALE, IM_DRAWVERT_POS_SCALE, 65535.0f, 65535.0f)), _mm_setr_ps(32768.5f, 32768.5f, 0.5f, 0.5f));
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(65535.0f));
+    __m128i i = _mm_sub_epi32(_mm_cvttps_epi32(v), _mm_set1_epi32(32768));
+    i = _mm_xor_si128(_mm_packs_epi32(i, i), _mm_setr_epi16(0, 0, (short)0x8000, (short)0x8000, 0, 0, 0, 0));
+    _mm_storel_epi64((__m128i*)vtx, i);
+    vtx->col = col;
+}
+#elif !defined(IMGUI_DISABLE_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+static inline void          ImDrawVertWrite(ImDrawVert* vtx, const ImVec2& pos, const ImVec2& uv, ImU32 col)
+{
+    const float in[4] = { pos.x, pos.y, uv.x, uv.y }, scale[4] = { IM_DRAWVERT_POS_SCALE, IM_DRAWVERT_POS_SCALE, 65535.0f, 65535.0f }, bias[4] = { 32768.5f, 32768.5f, 0.5f, 0.5f };
+    const uint16_t flip[4] = { 0, 0, 0x8000, 0x8000 };
+    float32x4_t v = vmlaq_f32(vld1q_f32(bias), vld1q_f32(in), vld1q_f32(scale));
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(65535.0f));
+    int32x4_t i = vsubq_s32(vcvtq_s32_f32(v), vdupq_n_s32(32768));
+    vst1_u16((uint16_t*)vtx, veor_u16(vreinterpret_u16_s16(vqmovn_s32(i)), vld1_u16(flip)));
+    vtx->col = col;
+}
+#else
+static inline short         ImDrawVertPackPos(float v)  { v = v * IM_DRAWVERT_POS_SCALE + 32768.5f; v = (v > 0.0f) ? v : 0.0f; v = (v < 65535.0f) ? v : 65535.0f; return (short)((int)v - 32768); }
+static inline unsigned short ImDrawVertPackUV(float v)  { v = v * 65535.0f + 0.5f; v = (v > 0.0f) ? v : 0.0f; v = (v < 65535.0f) ? v : 65535.0f; return (unsigned short)(int)v; }
+static inline void          ImDrawVertWrite(ImDrawVert* vtx, const ImVec2& pos, const ImVec2& uv, ImU32 col) { vtx->pos[0] = ImDrawVertPackPos(pos.x); vtx->pos[1] = ImDrawVertPackPos(pos.y); vtx->uv[0] = ImDrawVertPackUV(uv.x); vtx->uv[1] = ImDrawVertPackUV(uv.y); vtx->col = col; }
+#endif
+static inline ImVec2        ImDrawVertGetPos(const ImDrawVert& vtx)  { return ImVec2(vtx.pos[0] / IM_DRAWVERT_POS_SCALE, vtx.pos[1] / IM_DRAWVERT_POS_SCALE); }
+#else
+static inline void          ImDrawVertWrite(ImDrawVert* vtx, const ImVec2& pos, const ImVec2& uv, ImU32 col) { vtx->pos = pos; vtx->uv = uv; vtx->col = col; }
+static inline ImVec2        ImDrawVertGetPos(const ImDrawVert& vtx)  { return vtx.pos; }
+#endif
+
 // Draw channels are used by the Columns API to "split" the render list into different channels while building, so items of each column can be batched together.
 // You can also use them to simulate drawing layers and submit primitives in a different order than how they will be rendered.
+// While split, the indices of every channel are written directly into a region of the list IdxBuffer, sized after what the channel used in the same split of the previous frame, so merging only has to concatenate the commands.
 struct ImDrawChannel
 {
     ImVector<ImDrawCmd>     CmdBuffer;
-    ImVector<ImDrawIdx>     IdxBuffer;
+    int                     IdxWrite;           // Offset in the list IdxBuffer where the next indices of this channel go
+    int                     IdxEnd;             // End of the region of IdxBuffer the channel is currently writing to
+    int                     IdxCount;           // Number of indices written while split
+    int                     IdxCountMax;        // Peak of IdxCount, including the worst case reserved by AddText() before giving back the unused part
+
+    ImDrawChannel() { IdxWrite = IdxEnd = IdxCount = IdxCountMax = 0; }
+};
+
+// Used by ImGuiWindowFlags_CachedDrawList: one entry per hashed call recorded in the previous frame, storing the buffers state before the call so we can rewind to it.
+struct ImDrawListCacheEntry
+{
+    ImU32                   Hash;               // Running hash of all calls up to and including this one
+    int                     CmdCount;           // CmdBuffer.Size before the call
+    int                     IdxCount;           // IdxBuffer.Size before the call
+    int                     VtxCount;           // VtxBuffer.Size before the call
+    ImDrawCmd               LastCmd;            // Copy of CmdBuffer.back() before the call (it gets modified in place by following calls)
+};
+
+// Everything a draw list reads from outside of itself while building. The draw lists of a context point to the one owned by the context (see ImGui::GetDrawListSharedData()).
+// To fill draw lists on other threads, give them a copy of it taken on the main thread: a list only reads its shared data, and never touches the ImGui context.
+// ImVector<> still allocates through ImGui::MemAlloc(), so the io.MemAllocFn/MemFreeFn of the context current on the building thread must be thread-safe (the default ones are).
+struct ImDrawListSharedData
+{
+    ImVec2                  TexUvWhitePixel;    // UV of a white pixel in the font atlas texture
+    ImFont*                 Font;               // Font used by AddText(pos, col, text) without font parameter
+    float                   FontSize;           // Font size used by AddText(pos, col, text) without font parameter
+    float                   CurveTessellationTol; // Same as ImGuiStyle::CurveTessellationTol
+    bool                    AntiAliasedLines;   // Same as ImGuiStyle::AntiAliasedLines
+    bool                    AntiAliasedShapes;  // Same as ImGuiStyle::AntiAliasedShapes
+    ImVec4                  ClipRectFullscreen; // Clip rect used by PushClipRectFullScreen()
+
+    IMGUI_API ImDrawListSharedData();
 };
 
 // Draw command list
@@ -1074,28 +1265,46 @@ struct ImDrawChannel
 // At the moment, each ImGui window contains its own ImDrawList but they could potentially be merged in the future.
 // If you want to add custom rendering within a window, you can use ImGui::GetWindowDrawList() to access the current draw list and add your own primitives.
 // You can interleave normal ImGui:: calls and adding primitives to the current draw list.
-// All positions are in screen coordinates (0,0=top-left, 1 pixel per unit). Primitives are always added to the list and not culled (culling is done at render time and at a higher-level by ImGui:: functions).
+// All positions are in screen coordinates (0,0=top-left, 1 pixel per unit). Primitives are always added to the list and not culled (culling is done at render time and at a higher-level by ImGui:: functions), unless you enable CpuCulling.
 // Note that this only gives you access to rendering polygons. If your intent is to create custom widgets and the publicly exposed functions/data aren't sufficient, you can add code in imgui_user.inl
 struct ImDrawList
 {
     // This is what you have to render
     ImVector<ImDrawCmd>     CmdBuffer;          // Commands. Typically 1 command = 1 gpu draw call.
-    ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
+    ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those, starting at ImDrawCmd::IdxOffset
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
 
+    // Options
+    bool                    CpuCulling;         // Skip the Add*() primitives whose bounding box is entirely outside the current clip rect, instead of letting the GPU scissor them (default: false). Worth enabling when submitting lots of custom primitives that are mostly out of view.
+
     // [Internal, used while building lists]
+    const ImDrawListSharedData* _Data;          // Pointer to shared data. If NULL on construction, uses the one of the context current when the list is first cleared.
     const char*             _OwnerName;         // Pointer to owner window's name (if any) for debugging
-    unsigned int            _VtxCurrentIdx;     // [Internal] == VtxBuffer.Size
+    unsigned int            _VtxCurrentIdx;     // [Internal] == VtxBuffer.Size - _VtxCurrentOffset
+    unsigned int            _VtxCurrentOffset;  // [Internal] VtxOffset of the commands being added to, bumped by PrimReserve() before 16-bit indices would overflow
     ImDrawVert*             _VtxWritePtr;       // [Internal] point within VtxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImDrawIdx*              _IdxWritePtr;       // [Internal] point within IdxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImVector<ImVec4>        _ClipRectStack;     // [Internal]
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
+    ImVector<ImVec4>        _TransformStack;    // [Internal] same layout as ImDrawCmd::Transform, already combined with the transforms below it
+    int                     _TransformCmdStart; // [Internal] index in CmdBuffer of the first command using the current transform
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     int                     _ChannelsCurrent;   // [Internal] current channel number (0)
     int                     _ChannelsCount;     // [Internal] number of active channels (1+)
     ImVector<ImDrawChannel> _Channels;          // [Internal] draw channels for columns API (not resized down so _ChannelsCount may be smaller than _Channels.Size)
-
-    ImDrawList() { _OwnerName = NULL; Clear(); }
+    ImVector<int>           _ChannelsIdxHints;  // [Internal] for each ChannelsSplit() of the last frame, in order: channels count then indices written to each channel
+    int                     _ChannelsIdxHintsPos; // [Internal] position of the record of the current or next split in _ChannelsIdxHints
+    int                     _CacheState;        // [Internal] ImGuiWindowFlags_CachedDrawList: 0 = off, 1 = stopped for this frame, 2 = recording, 3 = replaying previous frame
+    int                     _CacheCursor;       // [Internal] index of the next entry to match while replaying
+    ImU32                   _CacheHash;         // [Internal] running hash of the calls submitted this frame
+    bool                    _CacheReserveAllowed; // [Internal] set by a hashed call which is about to call PrimReserve()
+    ImVector<ImDrawListCacheEntry> _CacheEntries; // [Internal] calls recorded in the previous frame, terminated by an entry holding the final buffers state
+    int                     _CacheHits;         // [Internal] number of frames where the whole list was reused
+    int                     _CacheMisses;       // [Internal] number of frames where some primitives had to be tessellated
+    int                     _CacheBytesSaved;   // [Internal] bytes of vertices/indices reused during the last frame
+    int                     _CulledCount;       // [Internal] number of primitives skipped by CpuCulling since the list was cleared
+
+    ImDrawList(const ImDrawListSharedData* shared_data = NULL) { _Data = shared_data; CpuCulling = false; _OwnerName = NULL; _CacheState = 0; _CacheHits = _CacheMisses = _CacheBytesSaved = 0; Clear(); }
     ~ImDrawList() { ClearFreeMemory(); }
     IMGUI_API void  Clear();
     IMGUI_API void  ClearFreeMemory();
@@ -1104,6 +1313,8 @@ struct ImDrawList
     IMGUI_API void  PopClipRect();
     IMGUI_API void  PushTextureID(const ImTextureID& texture_id);
     IMGUI_API void  PopTextureID();
+    IMGUI_API void  PushTransform(const ImVec2& translate, const ImVec2& scale = ImVec2(1,1));  // Following primitives are given in a local space, which the renderer maps to the screen with 'pos * scale + translate' (see ImDrawCmd::Transform). Combined with the current transform. Clip rects stay in screen space. Your renderer needs to apply ImDrawCmd::Transform: only the OpenGL3 and software examples do.
+    IMGUI_API void  PopTransform();
 
     // Primitives
     IMGUI_API void  AddLine(const ImVec2& a, const ImVec2& b, ImU32 col, float thickness = 1.0f);
@@ -1111,8 +1322,8 @@ struct ImDrawList
     IMGUI_API void  AddRectFilled(const ImVec2& a, const ImVec2& b, ImU32 col, float rounding = 0.0f, int rounding_corners = 0x0F);
     IMGUI_API void  AddRectFilledMultiColor(const ImVec2& a, const ImVec2& b, ImU32 col_upr_left, ImU32 col_upr_right, ImU32 col_bot_right, ImU32 col_bot_left);
     IMGUI_API void  AddTriangleFilled(const ImVec2& a, const ImVec2& b, const ImVec2& c, ImU32 col);
-    IMGUI_API void  AddCircle(const ImVec2& centre, float radius, ImU32 col, int num_segments = 12);
-    IMGUI_API void  AddCircleFilled(const ImVec2& centre, float radius, ImU32 col, int num_segments = 12);
+    IMGUI_API void  AddCircle(const ImVec2& centre, float radius, ImU32 col, int num_segments = 0);                        // 0 segments: derived from radius and style.CurveTessellationTol
+    IMGUI_API void  AddCircleFilled(const ImVec2& centre, float radius, ImU32 col, int num_segments = 0);
     IMGUI_API void  AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL);
     IMGUI_API void  AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL, float wrap_width = 0.0f, const ImVec4* cpu_fine_clip_rect = NULL);
     IMGUI_API void  AddImage(ImTextureID user_texture_id, const ImVec2& a, const ImVec2& b, const ImVec2& uv0 = ImVec2(0,0), const ImVec2& uv1 = ImVec2(1,1), ImU32 col = 0xFFFFFFFF);
@@ -1127,7 +1338,7 @@ struct ImDrawList
     inline    void  PathFill(ImU32 col)                                         { AddConvexPolyFilled(_Path.Data, _Path.Size, col, true); PathClear(); }
     inline    void  PathStroke(ImU32 col, bool closed, float thickness = 1.0f)  { AddPolyline(_Path.Data, _Path.Size, col, closed, thickness, true); PathClear(); }
     IMGUI_API void  PathArcTo(const ImVec2& centre, float radius, float a_min, float a_max, int num_segments = 10);
-    IMGUI_API void  PathArcToFast(const ImVec2& centre, float radius, int a_min_of_12, int a_max_of_12);                 // Use precomputed angles for a 12 steps circle
+    IMGUI_API void  PathArcToFast(const ImVec2& centre, float radius, int a_min_of_12, int a_max_of_12);                 // Use precomputed angles, segment count derived from radius and style.CurveTessellationTol
     IMGUI_API void  PathBezierCurveTo(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, int num_segments = 0);
     IMGUI_API void  PathRect(const ImVec2& rect_min, const ImVec2& rect_max, float rounding = 0.0f, int rounding_corners = 0x0F);
 
@@ -1141,6 +1352,7 @@ struct ImDrawList
     // Advanced
     IMGUI_API void  AddCallback(ImDrawCallback callback, void* callback_data);  // Your rendering function must check for 'UserCallback' in ImDrawCmd and call the function instead of rendering triangles.
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
+    IMGUI_API int   OptimizeDrawCmds();                                         // Drop empty commands and merge neighbouring commands which can be drawn in a single call. Call once the list is complete, return the number of commands removed. Render() does it for you if io.OptimizeDrawCmds is set.
 
     // Internal helpers
     // NB: all primitives needs to be reserved via PrimReserve() beforehand!
@@ -1148,10 +1360,19 @@ struct ImDrawList
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
-    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
+    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ ImDrawVertWrite(_VtxWritePtr, pos, uv, col); _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                 { *_IdxWritePtr = idx; _IdxWritePtr++; }
+    inline    int   PrimIdxWriteOffset() const                                  { return (_ChannelsCount > 1) ? _Channels.Data[_ChannelsCurrent].IdxWrite : IdxBuffer.Size; } // Where PrimReserve() will put the next indices
     IMGUI_API void  UpdateClipRect();
     IMGUI_API void  UpdateTextureID();
+    IMGUI_API void  UpdateTransform();
+    inline    ImVec4 GetCurrentTransform() const                                { return _TransformStack.Size ? _TransformStack.back() : ImVec4(1.0f, 1.0f, 0.0f, 0.0f); }
+    IMGUI_API void  CacheBegin();                                               // Like Clear() but keep last frame's buffers around so that matching calls can be reused (ImGuiWindowFlags_CachedDrawList)
+    IMGUI_API void  CacheEnd();                                                 // Finalize buffers before rendering. Called by Render().
+    IMGUI_API bool  CacheReplayCall(const void* key, int key_size, bool reserves); // Return true if the call was already in the buffers
+    IMGUI_API void  CacheRewind();
+    IMGUI_API void  CacheStop();
+    IMGUI_API void  CacheReplayTransform();
 };
 
 // All draw data to render an ImGui frame
@@ -1163,9 +1384,16 @@ struct ImDrawData
     int             TotalVtxCount;          // For convenience, sum of all cmd_lists vtx_buffer.Size
     int             TotalIdxCount;          // For convenience, sum of all cmd_lists idx_buffer.Size
 
+    // Optional frame-wide buffers, only filled by ConsolidateBuffers()
+    ImVector<ImDrawVert>    VtxBuffer;          // Vertices of all cmd_lists, one after the other
+    ImVector<ImDrawIdx>     IdxBuffer;          // Indices of all cmd_lists, one after the other. They are not modified: a command of cmd_lists[n] indexes VtxBuffer from CmdListsVtxOffset[n] + ImDrawCmd::VtxOffset.
+    ImVector<int>           CmdListsVtxOffset;  // Start of each cmd_lists[n] vertices in VtxBuffer
+    ImVector<int>           CmdListsIdxOffset;  // Start of each cmd_lists[n] indices in IdxBuffer
+
     // Functions
     ImDrawData() { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; }
     IMGUI_API void DeIndexAllBuffers();               // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
+    IMGUI_API void ConsolidateBuffers();              // Copy the vertices/indices of all cmd_lists into VtxBuffer/IdxBuffer, so you can upload them at once and bind a single vertex/index buffer per frame. Render with a base vertex (e.g. glDrawElementsBaseVertex) to apply the offsets.
     IMGUI_API void ScaleClipRects(const ImVec2& sc);  // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
 
@@ -1222,6 +1450,16 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     void                        SetTexID(void* id)  { TexID = id; }
 
+    // Icons: small RGBA32 images packed in the same texture as the glyphs, so they can be drawn with Image() without breaking the batching of text and frames.
+    // Call AddIcon() before building the atlas, it returns an identifier to pass to GetIconTexUV() after the build. Pixels are copied, in the same byte order as ImU32 colors.
+    // Icons colors are only available with GetTexDataAsRGBA32(), which you need to call before ClearInputData(). GetTexDataAsAlpha8() only receives their alpha channel.
+    // e.g. io.Fonts->GetIconTexUV(icon_id, &uv0, &uv1); ImGui::Image(io.Fonts->TexID, size, uv0, uv1);
+    IMGUI_API int               AddIcon(int width, int height, const unsigned int* pixels);
+    IMGUI_API void              GetIconTexUV(int icon_id, ImVec2* out_uv0, ImVec2* out_uv1) const;
+
+    // Mouse cursors drawn by ImGui when io.MouseDrawCursor is set are also stored in the texture. Valid after building the atlas.
+    IMGUI_API bool              GetMouseCursorTexData(ImGuiMouseCursor cursor, ImVec2* out_offset, ImVec2* out_size, ImVec2 out_uv_fill[2], ImVec2 out_uv_border[2]) const;
+
     // Helpers to retrieve list of common Unicode ranges (2 value per range, values are inclusive, zero-terminated list)
     // (Those functions could be static but aren't so most users don't have to refer to the ImFontAtlas:: name ever if in their code; just using io.Fonts->)
     IMGUI_API const ImWchar*    GetGlyphRangesDefault();    // Basic Latin, Extended Latin
@@ -1242,7 +1480,16 @@ struct ImFontAtlas
     ImVector<ImFont*>           Fonts;
 
     // Private
+    struct Icon
+    {
+        int                     Width, Height;
+        unsigned int*           Pixels;             // Copy of the pixels given to AddIcon(), freed by ClearInputData()
+        int                     X, Y;               // Position in the texture, calculated during Build()
+        ImVec2                  Uv0, Uv1;
+    };
     ImVector<ImFontConfig>      ConfigData;         // Internal data
+    ImVector<Icon>              Icons;
+    ImVec2                      TexExtraDataPos;    // Position of the custom data block (white pixel, mouse cursors) in the texture, calculated during Build()
     IMGUI_API bool              Build();            // Build pixels data. This is automatically for you by the GetTexData*** functions.
     IMGUI_API void              RenderCustomTexData(int pass, void* rects);
 };
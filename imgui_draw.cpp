@@ -26,6 +26,15 @@
 #endif
 #endif
 
+// SIMD code paths for tessellation (SSE2 on x86/x64, NEON on AArch64). Define IMGUI_DISABLE_SIMD in imconfig.h to only use the scalar code.
+#if !defined(IMGUI_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_SIMD_SSE2
+#include <emmintrin.h>
+#elif !defined(IMGUI_DISABLE_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define IMGUI_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (disable: 4505) // unreferenced local function has been removed (stb stuff)
 #pragma warning (disable: 4996) // 'This function or variable may be unsafe': strcpy, strdup, sprintf, vsnprintf, sscanf, fopen
@@ -96,19 +105,38 @@ using namespace IMGUI_STB_NAMESPACE;
 
 static ImVec4 GNullClipRect(-8192.0f, -8192.0f, +8192.0f, +8192.0f); // Large values that are easy to encode in a few bits+shift
 
+ImDrawListSharedData::ImDrawListSharedData()
+{
+    TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+    Font = NULL;
+    FontSize = 0.0f;
+    CurveTessellationTol = 1.25f;
+    AntiAliasedLines = AntiAliasedShapes = true;
+    ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, +8192.0f, +8192.0f);  // Same as GNullClipRect, which may not be initialized yet when constructing the default context
+}
+
 void ImDrawList::Clear()
 {
+    if (_Data == NULL)
+        _Data = ImGui::GetDrawListSharedData();
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
     _VtxCurrentIdx = 0;
+    _VtxCurrentOffset = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
     _ClipRectStack.resize(0);
     _TextureIdStack.resize(0);
+    _TransformStack.resize(0);
+    _TransformCmdStart = 0;
     _Path.resize(0);
     _ChannelsCurrent = 0;
     _ChannelsCount = 1;
+    _ChannelsIdxHintsPos = 0;
+    _CacheState = 0;
+    _CacheEntries.resize(0);
+    _CulledCount = 0;
     // NB: Do not clear channels so our allocations are re-used after the first frame.
 }
 
@@ -118,27 +146,217 @@ void ImDrawList::ClearFreeMemory()
     IdxBuffer.clear();
     VtxBuffer.clear();
     _VtxCurrentIdx = 0;
+    _VtxCurrentOffset = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
     _ClipRectStack.clear();
     _TextureIdStack.clear();
+    _TransformStack.clear();
+    _TransformCmdStart = 0;
     _Path.clear();
     _ChannelsCurrent = 0;
     _ChannelsCount = 1;
     for (int i = 0; i < _Channels.Size; i++)
     {
-        if (i == 0) memset(&_Channels[0], 0, sizeof(_Channels[0]));  // channel 0 is a copy of CmdBuffer/IdxBuffer, don't destruct again
+        if (i == 0) memset(&_Channels[0].CmdBuffer, 0, sizeof(_Channels[0].CmdBuffer));  // channel 0 is a copy of CmdBuffer, don't destruct again
         _Channels[i].CmdBuffer.clear();
-        _Channels[i].IdxBuffer.clear();
     }
     _Channels.clear();
+    _ChannelsIdxHints.clear();
+    _ChannelsIdxHintsPos = 0;
+    _CacheState = 0;
+    _CacheEntries.clear();
+}
+
+//-----------------------------------------------------------------------------
+// ImDrawList caching (ImGuiWindowFlags_CachedDrawList)
+//-----------------------------------------------------------------------------
+// Every call which affects the buffers (primitives, clip rect and texture changes, callbacks) folds its parameters into a running hash.
+// While the running hash matches the one recorded at the same position in the previous frame, the output of the call is already in the buffers and we skip it.
+// On the first mismatch we rewind the buffers to the state they had before that call in the previous frame, and carry on tessellating normally.
+// Anything we cannot hash (PrimReserve() or AddDrawCmd() called directly, channels) stops caching for the rest of the frame.
+//-----------------------------------------------------------------------------
+
+enum ImDrawListCacheCall_
+{
+    ImDrawListCacheCall_Seed,
+    ImDrawListCacheCall_PushClipRect,
+    ImDrawListCacheCall_PopClipRect,
+    ImDrawListCacheCall_PushTextureID,
+    ImDrawListCacheCall_PopTextureID,
+    ImDrawListCacheCall_Callback,
+    ImDrawListCacheCall_Polyline,
+    ImDrawListCacheCall_ConvexPolyFilled,
+    ImDrawListCacheCall_RectFilled,
+    ImDrawListCacheCall_RectFilledMultiColor,
+    ImDrawListCacheCall_Text,
+    ImDrawListCacheCall_Image,
+    ImDrawListCacheCall_PushTransform,
+    ImDrawListCacheCall_PopTransform
+};
+
+// Accumulate the parameters of a call as 32-bit words, to be hashed in one go.
+struct ImDrawListCacheKey
+{
+    ImU32   Data[16];
+    int     Size;
+
+    ImDrawListCacheKey(ImU32 call_type)     { Size = 0; Data[Size++] = call_type; }
+    void    Add(ImU32 v)                    { IM_ASSERT(Size < IM_ARRAYSIZE(Data)); Data[Size++] = v; }
+    void    Add(float v)                    { ImU32 u; memcpy(&u, &v, sizeof(u)); Add(u); }
+    void    Add(const ImVec2& v)            { Add(v.x); Add(v.y); }
+    void    Add(const ImVec4& v)            { Add(v.x); Add(v.y); Add(v.z); Add(v.w); }
+    void    Add(const void* ptr)            { unsigned long long int v = (unsigned long long int)(size_t)ptr; Add((ImU32)v); Add((ImU32)(v >> 32)); }
+};
+
+void ImDrawList::CacheBegin()
+{
+    if (_CacheState != 0)
+        CacheEnd();
+
+    // Same as Clear() but we leave the buffers alone
+    _VtxWritePtr = NULL;
+    _IdxWritePtr = NULL;
+    _ClipRectStack.resize(0);
+    _TextureIdStack.resize(0);
+    _TransformStack.resize(0);
+    _TransformCmdStart = 0;
+    _Path.resize(0);
+    _ChannelsCurrent = 0;
+    _ChannelsCount = 1;
+    _ChannelsIdxHintsPos = 0;
+
+    // Global state affecting tessellation is folded into the seed so a change invalidates the whole list
+    ImDrawListCacheKey key(ImDrawListCacheCall_Seed);
+    key.Add(_Data->TexUvWhitePixel);
+    key.Add((ImU32)_Data->AntiAliasedLines);
+    key.Add((ImU32)_Data->AntiAliasedShapes);
+    key.Add(_Data->CurveTessellationTol);
+    _CacheHash = ImHash(key.Data, key.Size * sizeof(ImU32), 0);
+    _CacheCursor = 0;
+    _CacheReserveAllowed = false;
+    _CacheBytesSaved = 0;
+    _CulledCount = 0;
+    if (_CacheEntries.Size > 0)
+    {
+        _CacheState = 3;
+    }
+    else
+    {
+        CmdBuffer.resize(0);
+        IdxBuffer.resize(0);
+        VtxBuffer.resize(0);
+        _VtxCurrentIdx = 0;
+        _VtxCurrentOffset = 0;
+        _CacheState = 2;
+    }
+}
+
+void ImDrawList::CacheEnd()
+{
+    if (_CacheState == 0)
+        return;
+
+    if (_CacheState == 3 && _CacheCursor == _CacheEntries.Size - 1)
+    {
+        // Every call matched: the buffers are exactly last frame's
+        _CacheBytesSaved += VtxBuffer.Size * (int)sizeof(ImDrawVert) + IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        _CacheHits++;
+    }
+    else
+    {
+        // Fewer calls than last frame: drop the tail
+        if (_CacheState == 3)
+            CacheRewind();
+        if (_CacheState == 2)
+            CacheStop();
+        _CacheMisses++;
+    }
+    _CacheState = 0;
+}
+
+// Hash a call and try to match it against the previous frame. 'reserves' is true if the call is going to use PrimReserve().
+bool ImDrawList::CacheReplayCall(const void* key, int key_size, bool reserves)
+{
+    _CacheHash = ImHash(key, key_size, _CacheHash);
+    if (_CacheState == 3)
+    {
+        // The last entry only holds the final state of the buffers and never matches
+        if (_CacheCursor < _CacheEntries.Size - 1 && _CacheEntries[_CacheCursor].Hash == _CacheHash)
+        {
+            _CacheCursor++;
+            return true;
+        }
+        CacheRewind();
+    }
+
+    ImDrawListCacheEntry entry;
+    entry.Hash = _CacheHash;
+    entry.CmdCount = CmdBuffer.Size;
+    entry.IdxCount = IdxBuffer.Size;
+    entry.VtxCount = VtxBuffer.Size;
+    if (CmdBuffer.Size > 0)
+        entry.LastCmd = CmdBuffer.back();
+    _CacheEntries.push_back(entry);
+    _CacheReserveAllowed = reserves;
+    return false;
+}
+
+// Restore the buffers to their state before the current call in the previous frame, and switch to recording.
+void ImDrawList::CacheRewind()
+{
+    IM_ASSERT(_CacheState == 3);
+    const ImDrawListCacheEntry& entry = _CacheEntries[_CacheCursor];
+    CmdBuffer.resize(entry.CmdCount);   // May grow back by one command if the trailing empty command was removed when rendering
+    if (CmdBuffer.Size > 0)
+    {
+        CmdBuffer.back() = entry.LastCmd;
+        CmdBuffer.back().Transform = GetCurrentTransform();  // Not hashed, see CacheReplayTransform(). PushTransform()/PopTransform() only change the stack after a rewind.
+    }
+    IdxBuffer.resize(entry.IdxCount);
+    VtxBuffer.resize(entry.VtxCount);
+    _VtxCurrentOffset = (CmdBuffer.Size > 0) ? CmdBuffer.back().VtxOffset : 0;
+    _VtxCurrentIdx = (unsigned int)VtxBuffer.Size - _VtxCurrentOffset;
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+    _CacheBytesSaved += entry.VtxCount * (int)sizeof(ImDrawVert) + entry.IdxCount * (int)sizeof(ImDrawIdx);
+    _CacheEntries.resize(_CacheCursor);
+    _CacheState = 2;
+}
+
+// Stop caching for the rest of the frame. The calls recorded so far can still be reused next frame.
+void ImDrawList::CacheStop()
+{
+    if (_CacheState == 3)
+        CacheRewind();
+    if (_CacheState == 2)
+    {
+        ImDrawListCacheEntry entry;
+        entry.Hash = 0;
+        entry.CmdCount = CmdBuffer.Size;
+        entry.IdxCount = IdxBuffer.Size;
+        entry.VtxCount = VtxBuffer.Size;
+        if (CmdBuffer.Size > 0)
+            entry.LastCmd = CmdBuffer.back();
+        _CacheEntries.push_back(entry);
+        _CacheState = 1;
+    }
 }
 
 void ImDrawList::AddDrawCmd()
 {
+    if (_CacheState == 3)
+        CacheStop();
+
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _ClipRectStack.Size ? _ClipRectStack.back() : GNullClipRect;
     draw_cmd.TextureId = _TextureIdStack.Size ? _TextureIdStack.back() : NULL;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    draw_cmd.TextureIds[0] = draw_cmd.TextureId;
+#endif
+    draw_cmd.VtxOffset = _VtxCurrentOffset;
+    draw_cmd.IdxOffset = (unsigned int)PrimIdxWriteOffset();
+    draw_cmd.Transform = GetCurrentTransform();
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -146,6 +364,15 @@ void ImDrawList::AddDrawCmd()
 
 void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 {
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_Callback);
+        key.Add((const void*)callback);
+        key.Add(callback_data);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false))
+            return;
+    }
+
     ImDrawCmd* current_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
     if (!current_cmd || current_cmd->ElemCount != 0 || current_cmd->UserCallback != NULL)
     {
@@ -168,8 +395,11 @@ void ImDrawList::UpdateClipRect()
     }
     else
     {
+        // While recording for the cache, don't merge across a transform change even when the values match, as they may not match when replaying (see CacheReplayTransform())
         ImVec4 current_clip_rect = _ClipRectStack.Size ? _ClipRectStack.back() : GNullClipRect;
-        if (CmdBuffer.Size >= 2 && ImLengthSqr(CmdBuffer.Data[CmdBuffer.Size-2].ClipRect - current_clip_rect) < 0.00001f)
+        const ImDrawCmd* prev_cmd = CmdBuffer.Size >= 2 ? &CmdBuffer.Data[CmdBuffer.Size-2] : NULL;
+        const bool same_transform = prev_cmd && memcmp(&prev_cmd->Transform, &current_cmd->Transform, sizeof(ImVec4)) == 0 && (_CacheState != 2 || CmdBuffer.Size-2 >= _TransformCmdStart);
+        if (prev_cmd && same_transform && ImLengthSqr(prev_cmd->ClipRect - current_clip_rect) < 0.00001f && prev_cmd->VtxOffset == current_cmd->VtxOffset && prev_cmd->IdxOffset + prev_cmd->ElemCount == current_cmd->IdxOffset)
             CmdBuffer.pop_back();
         else
             current_cmd->ClipRect = current_clip_rect;
@@ -180,22 +410,31 @@ void ImDrawList::UpdateClipRect()
 void ImDrawList::PushClipRect(const ImVec4& clip_rect)
 {
     _ClipRectStack.push_back(clip_rect);
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_PushClipRect);
+        key.Add(clip_rect);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false))
+            return;
+    }
     UpdateClipRect();
 }
 
 void ImDrawList::PushClipRectFullScreen()
 {
-    PushClipRect(GNullClipRect);
-
-    // FIXME-OPT: This would be more correct but we're not supposed to access ImGuiState from here?
-    //ImGuiState& g = *GImGui;
-    //PushClipRect(GetVisibleRect());
+    PushClipRect(_Data->ClipRectFullscreen);
 }
 
 void ImDrawList::PopClipRect()
 {
     IM_ASSERT(_ClipRectStack.Size > 0);
     _ClipRectStack.pop_back();
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_PopClipRect);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false))
+            return;
+    }
     UpdateClipRect();
 }
 
@@ -203,15 +442,33 @@ void ImDrawList::UpdateTextureID()
 {
     ImDrawCmd* current_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
     const ImTextureID texture_id = _TextureIdStack.Size ? _TextureIdStack.back() : NULL;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    // A command can sample several textures: PrimReserve() gives the texture a slot in the current command when it gets used
+    if (!current_cmd || current_cmd->UserCallback != NULL)
+        AddDrawCmd();
+    else if (current_cmd->ElemCount == 0)
+    {
+        current_cmd->TextureId = current_cmd->TextureIds[0] = texture_id;
+        current_cmd->TextureIdsCount = 1;
+    }
+#else
     if (!current_cmd || (current_cmd->ElemCount != 0 && current_cmd->TextureId != texture_id) || current_cmd->UserCallback != NULL)
         AddDrawCmd();
     else
         current_cmd->TextureId = texture_id;
+#endif
 }
 
 void ImDrawList::PushTextureID(const ImTextureID& texture_id)
 {
     _TextureIdStack.push_back(texture_id);
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_PushTextureID);
+        key.Add((const void*)texture_id);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false))
+            return;
+    }
     UpdateTextureID();
 }
 
@@ -219,42 +476,126 @@ void ImDrawList::PopTextureID()
 {
     IM_ASSERT(_TextureIdStack.Size > 0);
     _TextureIdStack.pop_back();
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_PopTextureID);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false))
+            return;
+    }
     UpdateTextureID();
 }
 
+// Unlike clip rects, commands are never merged back on a transform change: this keeps the commands using a transform identical when only its value changes.
+void ImDrawList::UpdateTransform()
+{
+    ImDrawCmd* current_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
+    if (!current_cmd || current_cmd->ElemCount != 0 || current_cmd->UserCallback != NULL)
+        AddDrawCmd();
+    else
+        current_cmd->Transform = GetCurrentTransform();
+    _TransformCmdStart = CmdBuffer.Size - 1;
+}
+
+// The new transform is given in the local space of the current one.
+// With ImGuiWindowFlags_CachedDrawList the values aren't hashed, so a canvas submitted in local space can be panned or zoomed without being tessellated again
+// (unless CpuCulling is enabled and primitives move in or out of view). Zooming also scales the anti-aliasing fringes.
+void ImDrawList::PushTransform(const ImVec2& translate, const ImVec2& scale)
+{
+    // Match the call before changing the stack: on a mismatch, CacheRewind() gives the current command the transform which applied before the call
+    bool replayed = false;
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_PushTransform);
+        replayed = CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false);
+    }
+    const ImVec4 current = GetCurrentTransform();
+    _TransformStack.push_back(ImVec4(current.x * scale.x, current.y * scale.y, current.x * translate.x + current.z, current.y * translate.y + current.w));
+    if (replayed)
+        CacheReplayTransform();
+    else
+        UpdateTransform();
+}
+
+void ImDrawList::PopTransform()
+{
+    IM_ASSERT(_TransformStack.Size > 0);
+    bool replayed = false;
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_PopTransform);
+        replayed = CacheReplayCall(key.Data, key.Size * sizeof(ImU32), false);
+    }
+    _TransformStack.pop_back();
+    if (replayed)
+        CacheReplayTransform();
+    else
+        UpdateTransform();
+}
+
+// Called after replaying PushTransform() or PopTransform(): the commands from the one started by the call in the previous frame get the new value.
+// The following transform calls will overwrite the value of their own commands.
+void ImDrawList::CacheReplayTransform()
+{
+    IM_ASSERT(_CacheState == 3 && _CacheCursor < _CacheEntries.Size);
+    _TransformCmdStart = _CacheEntries[_CacheCursor].CmdCount - 1;
+    const ImVec4 transform = GetCurrentTransform();
+    for (int i = _TransformCmdStart; i < CmdBuffer.Size; i++)
+        CmdBuffer.Data[i].Transform = transform;
+}
+
 void ImDrawList::ChannelsSplit(int channels_count)
 {
     IM_ASSERT(_ChannelsCurrent == 0 && _ChannelsCount == 1);
+    if (_CacheState >= 2)
+        CacheStop();
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
+    {
         _Channels.resize(channels_count);
+        for (int i = old_channels_count; i < channels_count; i++)
+            new(&_Channels[i]) ImDrawChannel();
+    }
     _ChannelsCount = channels_count;
 
-    // _Channels[] (24 bytes each) hold storage that we'll swap with this->_CmdBuffer/_IdxBuffer
-    // The content of _Channels[0] at this point doesn't matter. We clear it to make state tidy in a debugger but we don't strictly need to.
-    // When we switch to the next channel, we'll copy _CmdBuffer/_IdxBuffer into _Channels[0] and then _Channels[1] into _CmdBuffer/_IdxBuffer
-    memset(&_Channels[0], 0, sizeof(ImDrawChannel));
+    // _Channels[] hold storage that we'll swap with this->_CmdBuffer
+    // The content of _Channels[0].CmdBuffer at this point doesn't matter. We clear it to make state tidy in a debugger but we don't strictly need to.
+    // When we switch to the next channel, we'll copy _CmdBuffer into _Channels[0] and then _Channels[1] into _CmdBuffer
+    memset(&_Channels[0].CmdBuffer, 0, sizeof(_Channels[0].CmdBuffer));
+
+    // Lay out one region of IdxBuffer per channel, in their final order, sized after the same split in the previous frame (matched by order of calls).
+    // A channel outgrowing its region carries on in a new one at the end of the buffer (see PrimReserve()).
+    const int* hints = NULL;
+    if (_ChannelsIdxHintsPos < _ChannelsIdxHints.Size && _ChannelsIdxHints[_ChannelsIdxHintsPos] == channels_count)
+        hints = &_ChannelsIdxHints[_ChannelsIdxHintsPos + 1];
+    int idx_offset = IdxBuffer.Size;
+    for (int i = 0; i < channels_count; i++)
+    {
+        ImDrawChannel& ch = _Channels[i];
+        ch.IdxWrite = idx_offset;
+        idx_offset += hints ? hints[i] : 0;
+        ch.IdxEnd = idx_offset;
+        ch.IdxCount = ch.IdxCountMax = 0;
+    }
+    IdxBuffer.resize(idx_offset);
+
     for (int i = 1; i < channels_count; i++)
     {
-        if (i >= old_channels_count)
-        {
-            new(&_Channels[i]) ImDrawChannel();
-        }
-        else
-        {
-            _Channels[i].CmdBuffer.resize(0);
-            _Channels[i].IdxBuffer.resize(0);
-        }
-        if (_Channels[i].CmdBuffer.Size == 0)
-        {
-            ImDrawCmd draw_cmd;
-            draw_cmd.ClipRect = _ClipRectStack.back();
-            draw_cmd.TextureId = _TextureIdStack.back();
-            _Channels[i].CmdBuffer.push_back(draw_cmd);
-        }
+        _Channels[i].CmdBuffer.resize(0);
+        ImDrawCmd draw_cmd;
+        draw_cmd.ClipRect = _ClipRectStack.back();
+        draw_cmd.TextureId = _TextureIdStack.back();
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+        draw_cmd.TextureIds[0] = draw_cmd.TextureId;
+#endif
+        draw_cmd.VtxOffset = _VtxCurrentOffset;
+        draw_cmd.IdxOffset = (unsigned int)_Channels[i].IdxWrite;
+        draw_cmd.Transform = GetCurrentTransform();
+        _Channels[i].CmdBuffer.push_back(draw_cmd);
     }
 }
 
+// The indices are already in place, so this only appends the commands of each channel to the ones of channel 0.
+// The unused end of each region is left as a gap in IdxBuffer, never referenced by any command.
 void ImDrawList::ChannelsMerge()
 {
     // Note that we never use or rely on channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
@@ -265,68 +606,256 @@ void ImDrawList::ChannelsMerge()
     if (CmdBuffer.Size && CmdBuffer.back().ElemCount == 0)
         CmdBuffer.pop_back();
 
-    int new_cmd_buffer_count = 0, new_idx_buffer_count = 0;
-    for (int i = 1; i < _ChannelsCount; i++)
+    int new_cmd_buffer_count = 0, idx_buffer_size = 0;
+    for (int i = 0; i < _ChannelsCount; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (ch.CmdBuffer.Size && ch.CmdBuffer.back().ElemCount == 0)
-            ch.CmdBuffer.pop_back();
-        new_cmd_buffer_count += ch.CmdBuffer.Size;
-        new_idx_buffer_count += ch.IdxBuffer.Size;
+        if (i > 0)
+        {
+            if (ch.CmdBuffer.Size && ch.CmdBuffer.back().ElemCount == 0)
+                ch.CmdBuffer.pop_back();
+            new_cmd_buffer_count += ch.CmdBuffer.Size;
+        }
+        idx_buffer_size = ImMax(idx_buffer_size, ch.IdxWrite);
     }
     CmdBuffer.resize(CmdBuffer.Size + new_cmd_buffer_count);
-    IdxBuffer.resize(IdxBuffer.Size + new_idx_buffer_count);
+    IdxBuffer.resize(idx_buffer_size);   // Trim the unused end of the last region
+
+    // Record the size of each channel for the same split in the next frame
+    if (_ChannelsIdxHintsPos >= _ChannelsIdxHints.Size || _ChannelsIdxHints[_ChannelsIdxHintsPos] != _ChannelsCount)
+    {
+        _ChannelsIdxHints.resize(_ChannelsIdxHintsPos + 1 + _ChannelsCount);
+        _ChannelsIdxHints[_ChannelsIdxHintsPos] = _ChannelsCount;
+    }
+    for (int i = 0; i < _ChannelsCount; i++)
+        _ChannelsIdxHints[_ChannelsIdxHintsPos + 1 + i] = _Channels[i].IdxCountMax;
+    _ChannelsIdxHintsPos += 1 + _ChannelsCount;
 
     ImDrawCmd* cmd_write = CmdBuffer.Data + CmdBuffer.Size - new_cmd_buffer_count;
-    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size - new_idx_buffer_count;
     for (int i = 1; i < _ChannelsCount; i++)
     {
         ImDrawChannel& ch = _Channels[i];
         if (int sz = ch.CmdBuffer.Size) { memcpy(cmd_write, ch.CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
-        if (int sz = ch.IdxBuffer.Size) { memcpy(_IdxWritePtr, ch.IdxBuffer.Data, sz * sizeof(ImDrawIdx)); _IdxWritePtr += sz; }
     }
-    AddDrawCmd();
     _ChannelsCount = 1;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+    AddDrawCmd();
 }
 
 void ImDrawList::ChannelsSetCurrent(int idx)
 {
     IM_ASSERT(idx < _ChannelsCount);
     if (_ChannelsCurrent == idx) return;
-    memcpy(&_Channels.Data[_ChannelsCurrent].CmdBuffer, &CmdBuffer, sizeof(CmdBuffer)); // copy 12 bytes, four times
-    memcpy(&_Channels.Data[_ChannelsCurrent].IdxBuffer, &IdxBuffer, sizeof(IdxBuffer));
+    memcpy(&_Channels.Data[_ChannelsCurrent].CmdBuffer, &CmdBuffer, sizeof(CmdBuffer)); // copy 12 bytes, twice
     _ChannelsCurrent = idx;
     memcpy(&CmdBuffer, &_Channels.Data[_ChannelsCurrent].CmdBuffer, sizeof(CmdBuffer));
-    memcpy(&IdxBuffer, &_Channels.Data[_ChannelsCurrent].IdxBuffer, sizeof(IdxBuffer));
-    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + _Channels.Data[_ChannelsCurrent].IdxWrite;
+}
+
+// Bounding box of the triangles of a command
+static ImRect GetDrawCmdBounds(const ImDrawList* draw_list, const ImDrawCmd& cmd)
+{
+    ImRect bb;
+    const ImDrawIdx* idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+    const ImDrawVert* vtx = draw_list->VtxBuffer.Data + cmd.VtxOffset;
+    for (unsigned int i = 0; i < cmd.ElemCount; i++)
+        bb.Add(ImDrawVertGetPos(vtx[idx[i]]));
+    return ImDrawCmdTransformRect(cmd.Transform, bb);
+}
+
+// Triangles have to stay 2 pixels away from the edges of a clip rect to count as unclipped, as renderers round scissor rectangles in different ways.
+static bool IsDrawCmdUnclipped(const ImRect& bb, const ImVec4& clip_rect_a, const ImVec4& clip_rect_b)
+{
+    ImRect r = bb;
+    r.Expand(2.0f);
+    return ImRect(clip_rect_a).Contains(r) && ImRect(clip_rect_b).Contains(r);
+}
+
+// Commands sample the same textures if they have the same texture or, with texture slots, if the slots of one start with the slots of the other (the vertices don't need to be changed).
+static bool AreDrawCmdTexturesCompatible(const ImDrawCmd& a, const ImDrawCmd& b)
+{
+    if (a.TextureId != b.TextureId)
+        return false;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    for (int n = 1; n < a.TextureIdsCount && n < b.TextureIdsCount; n++)
+        if (a.TextureIds[n] != b.TextureIds[n])
+            return false;
+#endif
+    return true;
+}
+
+static inline void MergeDrawCmdTextures(ImDrawCmd* dst, const ImDrawCmd& src)
+{
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    for (int n = dst->TextureIdsCount; n < src.TextureIdsCount; n++)
+        dst->TextureIds[n] = src.TextureIds[n];
+    dst->TextureIdsCount = ImMax(dst->TextureIdsCount, src.TextureIdsCount);
+#else
+    (void)dst; (void)src;
+#endif
+}
+
+// Commands can be merged when they are both triangles with the same texture, transform, vertex offset and contiguous indices. Their clip rects must either be equal, or one of the
+// commands must be clipped neither by its own clip rect nor by the other one, in which case the merged command uses the clip rect of the other.
+int ImDrawList::OptimizeDrawCmds()
+{
+    IM_ASSERT(_ChannelsCount == 1);
+    int write_n = 0;
+    ImRect write_bb;
+    bool write_bb_valid = false;
+    for (int read_n = 0; read_n < CmdBuffer.Size; read_n++)
+    {
+        const ImDrawCmd cmd = CmdBuffer.Data[read_n];
+        if (cmd.ElemCount == 0 && cmd.UserCallback == NULL)
+            continue;
+
+        ImDrawCmd* prev = (write_n > 0) ? &CmdBuffer.Data[write_n - 1] : NULL;
+        if (prev && prev->UserCallback == NULL && cmd.UserCallback == NULL && AreDrawCmdTexturesCompatible(*prev, cmd) && prev->VtxOffset == cmd.VtxOffset && prev->IdxOffset + prev->ElemCount == cmd.IdxOffset && memcmp(&prev->Transform, &cmd.Transform, sizeof(ImVec4)) == 0)
+        {
+            if (memcmp(&prev->ClipRect, &cmd.ClipRect, sizeof(ImVec4)) == 0)
+            {
+                prev->ElemCount += cmd.ElemCount;
+                MergeDrawCmdTextures(prev, cmd);
+                write_bb_valid = false;
+                continue;
+            }
+
+            if (!write_bb_valid)
+                write_bb = GetDrawCmdBounds(this, *prev);
+            const ImRect cmd_bb = GetDrawCmdBounds(this, cmd);
+            const bool cmd_unclipped = IsDrawCmdUnclipped(cmd_bb, prev->ClipRect, cmd.ClipRect);
+            if (cmd_unclipped || IsDrawCmdUnclipped(write_bb, prev->ClipRect, cmd.ClipRect))
+            {
+                if (!cmd_unclipped)
+                    prev->ClipRect = cmd.ClipRect;
+                prev->ElemCount += cmd.ElemCount;
+                MergeDrawCmdTextures(prev, cmd);
+                write_bb.Add(cmd_bb);
+                write_bb_valid = true;
+                continue;
+            }
+            write_bb = cmd_bb;
+            write_bb_valid = true;
+        }
+        else
+        {
+            write_bb_valid = false;
+        }
+        CmdBuffer.Data[write_n++] = cmd;
+    }
+
+    // Keep a command to add to, as the list may still be appended to
+    const int removed_count = CmdBuffer.Size - write_n;
+    CmdBuffer.resize(write_n);
+    if (CmdBuffer.Size == 0)
+        AddDrawCmd();
+    return removed_count;
 }
 
 // NB: this can be called with negative count for removing primitives (as long as the result does not underflow)
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
-    ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
-    draw_cmd.ElemCount += idx_count;
+    if (_CacheState >= 2)
+    {
+        if (!_CacheReserveAllowed)
+            CacheStop();
+        _CacheReserveAllowed = false;
+    }
+
+    // With 16-bit indices, move the vertex offset forward before the indices of this primitive would overflow.
+    // Every channel shares the vertex buffer, so the current command may also be behind after switching channels.
+    if (sizeof(ImDrawIdx) == 2 && _VtxCurrentIdx != 0 && _VtxCurrentIdx + vtx_count > (1 << 16))
+    {
+        _VtxCurrentOffset = (unsigned int)VtxBuffer.Size;
+        _VtxCurrentIdx = 0;
+    }
+
+    // While split, a channel which outgrew its region of IdxBuffer carries on at the end of the buffer: extend the region in place if it is already last, otherwise start a new one.
+    // Regions grow at least by what the channel used so far, so a channel doesn't get fragmented into too many commands.
+    ImDrawChannel* ch = (_ChannelsCount > 1) ? &_Channels.Data[_ChannelsCurrent] : NULL;
+    if (ch && ch->IdxWrite + idx_count > ch->IdxEnd)
+    {
+        if (ch->IdxEnd != IdxBuffer.Size)
+            ch->IdxWrite = ch->IdxEnd = IdxBuffer.Size;
+        ch->IdxEnd += ImMax(ch->IdxWrite + idx_count - ch->IdxEnd, ch->IdxCount);
+        IdxBuffer.resize(ch->IdxEnd);
+    }
+    const int idx_write = PrimIdxWriteOffset();
+
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    if (draw_cmd->VtxOffset != _VtxCurrentOffset || draw_cmd->IdxOffset + draw_cmd->ElemCount != (unsigned int)idx_write)
+    {
+        if (draw_cmd->ElemCount == 0 && draw_cmd->UserCallback == NULL)
+        {
+            draw_cmd->VtxOffset = _VtxCurrentOffset;
+            draw_cmd->IdxOffset = (unsigned int)idx_write;
+        }
+        else
+        {
+            AddDrawCmd();
+            draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+        }
+    }
+
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    // Find the slot of the current texture in the command, add it if there is room left, otherwise start a new command
+    unsigned int tex_slot = 0;
+    if (vtx_count > 0)
+    {
+        const ImTextureID texture_id = _TextureIdStack.Size ? _TextureIdStack.back() : NULL;
+        while ((int)tex_slot < draw_cmd->TextureIdsCount && draw_cmd->TextureIds[tex_slot] != texture_id)
+            tex_slot++;
+        if ((int)tex_slot == draw_cmd->TextureIdsCount)
+        {
+            if (draw_cmd->ElemCount == 0 || tex_slot == IMGUI_DRAWCMD_TEXTURE_SLOTS)
+            {
+                if (draw_cmd->ElemCount != 0)
+                {
+                    AddDrawCmd();
+                    draw_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+                }
+                draw_cmd->TextureId = texture_id;
+                tex_slot = 0;
+            }
+            draw_cmd->TextureIds[tex_slot] = texture_id;
+            draw_cmd->TextureIdsCount = tex_slot + 1;
+        }
+    }
+#endif
+    draw_cmd->ElemCount += idx_count;
 
     int vtx_buffer_size = VtxBuffer.Size;
     VtxBuffer.resize(vtx_buffer_size + vtx_count);
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_size;
+#ifdef IMGUI_DRAWCMD_TEXTURE_SLOTS
+    for (int i = 0; i < vtx_count; i++)
+        _VtxWritePtr[i].tex = tex_slot;
+#endif
 
-    int idx_buffer_size = IdxBuffer.Size;
-    IdxBuffer.resize(idx_buffer_size + idx_count);
-    _IdxWritePtr = IdxBuffer.Data + idx_buffer_size;
+    if (ch)
+    {
+        ch->IdxWrite += idx_count;
+        ch->IdxCount += idx_count;
+        ch->IdxCountMax = ImMax(ch->IdxCountMax, ch->IdxCount);
+    }
+    else
+    {
+        IdxBuffer.resize(idx_write + idx_count);
+    }
+    _IdxWritePtr = IdxBuffer.Data + idx_write;
 }
 
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
-    const ImVec2 uv = GImGui->FontTexUvWhitePixel;
+    const ImVec2 uv = _Data->TexUvWhitePixel;
     const ImVec2 b(c.x, a.y);
     const ImVec2 d(a.x, c.y);
     _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
     _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx+2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+    ImDrawVertWrite(&_VtxWritePtr[0], a, uv, col);
+    ImDrawVertWrite(&_VtxWritePtr[1], b, uv, col);
+    ImDrawVertWrite(&_VtxWritePtr[2], c, uv, col);
+    ImDrawVertWrite(&_VtxWritePtr[3], d, uv, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -340,201 +869,388 @@ void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a
     const ImVec2 uv_d(uv_a.x, uv_c.y);
     _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
     _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx+2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    ImDrawVertWrite(&_VtxWritePtr[0], a, uv_a, col);
+    ImDrawVertWrite(&_VtxWritePtr[1], b, uv_b, col);
+    ImDrawVertWrite(&_VtxWritePtr[2], c, uv_c, col);
+    ImDrawVertWrite(&_VtxWritePtr[3], d, uv_d, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
 }
 
-// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
-void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness, bool anti_aliased)
-{
-    if (points_count < 2)
-        return;
+//-----------------------------------------------------------------------------
+// Polyline and polygon tessellation helpers
+//-----------------------------------------------------------------------------
+// Strokes are generated in a single pass as a strip: for each point we compute the normal of the next segment, average it with the normal
+// of the previous segment, then write the point vertices and the indices of the previous segment directly into the draw list buffers.
+// Consecutive segments share the vertices of their common point: 2 per point (non anti-aliased), 3 (anti-aliased thin) or 4 (anti-aliased thick).
+// Anti-aliased convex fills use the same join normals, with an inner and an outer fringe vertex per point.
+// The SIMD path processes 4 points at a time using the same operations in the same order as the scalar path, so the output is identical.
+// Indices follow a fixed pattern and are written 24 at a time, adding a constant step to a pattern (see PolygonWriteIdxPattern).
+//-----------------------------------------------------------------------------
 
-    const ImVec2 uv = GImGui->FontTexUvWhitePixel;
-    anti_aliased &= GImGui->Style.AntiAliasedLines;
-    //if (ImGui::GetIO().KeyCtrl) anti_aliased = false; // Debug
+// Maximum distance of a join corner from its point, in half-thicknesses. Sharper joins are clipped to that distance (along the bisector).
+#define IM_POLYLINE_MITER_LIMIT         4.0f
+#define IM_POLYLINE_MITER_LIMIT_DMR2    (1.0f / (IM_POLYLINE_MITER_LIMIT * IM_POLYLINE_MITER_LIMIT))
+
+#if defined(IMGUI_SIMD_SSE2)
+typedef __m128 ImSimdFloat4;
+static inline ImSimdFloat4 ImSimdSet1(float v)                                  { return _mm_set1_ps(v); }
+static inline ImSimdFloat4 ImSimdAdd(ImSimdFloat4 a, ImSimdFloat4 b)            { return _mm_add_ps(a, b); }
+static inline ImSimdFloat4 ImSimdSub(ImSimdFloat4 a, ImSimdFloat4 b)            { return _mm_sub_ps(a, b); }
+static inline ImSimdFloat4 ImSimdMul(ImSimdFloat4 a, ImSimdFloat4 b)            { return _mm_mul_ps(a, b); }
+static inline ImSimdFloat4 ImSimdDiv(ImSimdFloat4 a, ImSimdFloat4 b)            { return _mm_div_ps(a, b); }
+static inline ImSimdFloat4 ImSimdSqrt(ImSimdFloat4 a)                           { return _mm_sqrt_ps(a); }
+static inline ImSimdFloat4 ImSimdNeg(ImSimdFloat4 a)                            { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+static inline ImSimdFloat4 ImSimdSelectGt(ImSimdFloat4 a, ImSimdFloat4 b, ImSimdFloat4 if_gt, ImSimdFloat4 if_not_gt) { const __m128 m = _mm_cmpgt_ps(a, b); return _mm_or_ps(_mm_and_ps(m, if_gt), _mm_andnot_ps(m, if_not_gt)); }
+static inline ImSimdFloat4 ImSimdShiftIn(ImSimdFloat4 v, float first)           { return _mm_move_ss(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,1,0,0)), _mm_set_ss(first)); }  // (first, v.0, v.1, v.2)
+static inline void         ImSimdStore(float* out, ImSimdFloat4 v)              { _mm_storeu_ps(out, v); }
+static inline void         ImSimdLoadPoints(const ImVec2* p, ImSimdFloat4* out_x, ImSimdFloat4* out_y) { const __m128 a = _mm_loadu_ps(&p[0].x), b = _mm_loadu_ps(&p[2].x); *out_x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0)); *out_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1)); }
+typedef __m128i ImSimdIdx;                                                      // 8 (16-bit ImDrawIdx) or 4 (32-bit ImDrawIdx) indices
+static inline ImSimdIdx    ImSimdSet1Idx(unsigned int v)                        { return sizeof(ImDrawIdx) == 2 ? _mm_set1_epi16((short)v) : _mm_set1_epi32((int)v); }
+static inline ImSimdIdx    ImSimdLoadIdx(const ImDrawIdx* p)                    { return _mm_loadu_si128((const __m128i*)p); }
+static inline ImSimdIdx    ImSimdAddIdx(ImSimdIdx a, ImSimdIdx b)               { return sizeof(ImDrawIdx) == 2 ? _mm_add_epi16(a, b) : _mm_add_epi32(a, b); }
+static inline void         ImSimdStoreIdx(ImDrawIdx* out, ImSimdIdx v)          { _mm_storeu_si128((__m128i*)out, v); }
+#define IMGUI_SIMD
+#elif defined(IMGUI_SIMD_NEON)
+typedef float32x4_t ImSimdFloat4;
+static inline ImSimdFloat4 ImSimdSet1(float v)                                  { return vdupq_n_f32(v); }
+static inline ImSimdFloat4 ImSimdAdd(ImSimdFloat4 a, ImSimdFloat4 b)            { return vaddq_f32(a, b); }
+static inline ImSimdFloat4 ImSimdSub(ImSimdFloat4 a, ImSimdFloat4 b)            { return vsubq_f32(a, b); }
+static inline ImSimdFloat4 ImSimdMul(ImSimdFloat4 a, ImSimdFloat4 b)            { return vmulq_f32(a, b); }
+static inline ImSimdFloat4 ImSimdDiv(ImSimdFloat4 a, ImSimdFloat4 b)            { return vdivq_f32(a, b); }
+static inline ImSimdFloat4 ImSimdSqrt(ImSimdFloat4 a)                           { return vsqrtq_f32(a); }
+static inline ImSimdFloat4 ImSimdNeg(ImSimdFloat4 a)                            { return vnegq_f32(a); }
+static inline ImSimdFloat4 ImSimdSelectGt(ImSimdFloat4 a, ImSimdFloat4 b, ImSimdFloat4 if_gt, ImSimdFloat4 if_not_gt) { return vbslq_f32(vcgtq_f32(a, b), if_gt, if_not_gt); }
+static inline ImSimdFloat4 ImSimdShiftIn(ImSimdFloat4 v, float first)           { return vextq_f32(vdupq_n_f32(first), v, 3); }                                         // (first, v.0, v.1, v.2)
+static inline void         ImSimdStore(float* out, ImSimdFloat4 v)              { vst1q_f32(out, v); }
+static inline void         ImSimdLoadPoints(const ImVec2* p, ImSimdFloat4* out_x, ImSimdFloat4* out_y) { const float32x4x2_t v = vld2q_f32(&p[0].x); *out_x = v.val[0]; *out_y = v.val[1]; }
+typedef uint32x4_t ImSimdIdx;                                                   // 8 (16-bit ImDrawIdx) or 4 (32-bit ImDrawIdx) indices
+static inline ImSimdIdx    ImSimdSet1Idx(unsigned int v)                        { return sizeof(ImDrawIdx) == 2 ? vreinterpretq_u32_u16(vdupq_n_u16((uint16_t)v)) : vdupq_n_u32(v); }
+static inline ImSimdIdx    ImSimdLoadIdx(const ImDrawIdx* p)                    { return vreinterpretq_u32_u8(vld1q_u8((const uint8_t*)p)); }
+static inline ImSimdIdx    ImSimdAddIdx(ImSimdIdx a, ImSimdIdx b)               { return sizeof(ImDrawIdx) == 2 ? vreinterpretq_u32_u16(vaddq_u16(vreinterpretq_u16_u32(a), vreinterpretq_u16_u32(b))) : vaddq_u32(a, b); }
+static inline void         ImSimdStoreIdx(ImDrawIdx* out, ImSimdIdx v)          { vst1q_u8((uint8_t*)out, vreinterpretq_u8_u32(v)); }
+#define IMGUI_SIMD
+#endif
 
-    int count = points_count;
-    if (!closed)
-        count = points_count-1;
+// Normal of segment p1->p2
+static inline ImVec2 PolylineSegmentNormal(const ImVec2& p1, const ImVec2& p2)
+{
+    ImVec2 diff = p2 - p1;
+    diff *= ImInvLength(diff, 1.0f);
+    return ImVec2(diff.y, -diff.x);
+}
 
-    const bool thick_line = thickness > 1.0f;
-    if (anti_aliased)
+// Average the normals of two consecutive segments, scaled to reach the corner of the join (limited to IM_POLYLINE_MITER_LIMIT for sharp angles)
+static inline ImVec2 PolylineJoinNormal(const ImVec2& n1, const ImVec2& n2)
+{
+    ImVec2 dm = (n1 + n2) * 0.5f;
+    float dmr2 = dm.x*dm.x + dm.y*dm.y;
+    if (dmr2 > 0.000001f)
     {
-        // Anti-aliased stroke
-        const float AA_SIZE = 1.0f;
-        const ImU32 col_trans = col & 0x00ffffff;
-
-        const int idx_count = thick_line ? count*18 : count*12;
-        const int vtx_count = thick_line ? points_count*4 : points_count*3;
-        PrimReserve(idx_count, vtx_count);
+        // Past the miter limit (1/sqrt(dmr2) > limit), scale to a length of limit instead
+        const float scale = (IM_POLYLINE_MITER_LIMIT_DMR2 > dmr2) ? IM_POLYLINE_MITER_LIMIT / sqrtf(dmr2) : 1.0f / dmr2;
+        dm *= scale;
+    }
+    return dm;
+}
+
+#ifdef IMGUI_SIMD
+// Join normals of points[0..3] (see PolylineJoinNormal), given the normal of the segment ending at points[0]. Reads points[0..4].
+// On return n_prev is the normal of the segment starting at points[3].
+static inline void PolylineJoinNormals4(const ImVec2* points, ImVec2* n_prev, float* out_dmx, float* out_dmy)
+{
+    const ImSimdFloat4 zero = ImSimdSet1(0.0f), half = ImSimdSet1(0.5f), one = ImSimdSet1(1.0f), miter_limit = ImSimdSet1(IM_POLYLINE_MITER_LIMIT), miter_limit_dmr2 = ImSimdSet1(IM_POLYLINE_MITER_LIMIT_DMR2), epsilon = ImSimdSet1(0.000001f);
+    ImSimdFloat4 x1, y1, x2, y2;
+    ImSimdLoadPoints(points, &x1, &y1);
+    ImSimdLoadPoints(points + 1, &x2, &y2);
+    const ImSimdFloat4 dx = ImSimdSub(x2, x1);
+    const ImSimdFloat4 dy = ImSimdSub(y2, y1);
+    const ImSimdFloat4 d = ImSimdAdd(ImSimdMul(dx, dx), ImSimdMul(dy, dy));
+    const ImSimdFloat4 inv_len = ImSimdSelectGt(d, zero, ImSimdDiv(one, ImSimdSqrt(d)), one);
+    const ImSimdFloat4 nx = ImSimdMul(dy, inv_len);
+    const ImSimdFloat4 ny = ImSimdNeg(ImSimdMul(dx, inv_len));
+    ImSimdFloat4 dmx = ImSimdMul(ImSimdAdd(ImSimdShiftIn(nx, n_prev->x), nx), half);
+    ImSimdFloat4 dmy = ImSimdMul(ImSimdAdd(ImSimdShiftIn(ny, n_prev->y), ny), half);
+    const ImSimdFloat4 dmr2 = ImSimdAdd(ImSimdMul(dmx, dmx), ImSimdMul(dmy, dmy));
+    const ImSimdFloat4 scale = ImSimdSelectGt(miter_limit_dmr2, dmr2, ImSimdDiv(miter_limit, ImSimdSqrt(dmr2)), ImSimdDiv(one, dmr2));
+    dmx = ImSimdSelectGt(dmr2, epsilon, ImSimdMul(dmx, scale), dmx);
+    dmy = ImSimdSelectGt(dmr2, epsilon, ImSimdMul(dmy, scale), dmy);
+
+    float out_nx[4], out_ny[4];
+    ImSimdStore(out_dmx, dmx);
+    ImSimdStore(out_dmy, dmy);
+    ImSimdStore(out_nx, nx);
+    ImSimdStore(out_ny, ny);
+    *n_prev = ImVec2(out_nx[3], out_ny[3]);
+}
+#endif
 
-        // Temporary buffer
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2));
-        ImVec2* temp_points = temp_normals + points_count;
+// Write the vertices of a point of a stroke. vtx_stride is 2 (non anti-aliased, half_inner_thickness is then the half thickness), 3 (anti-aliased thin) or 4 (anti-aliased thick).
+static inline ImDrawVert* PolylineWriteVtx(ImDrawVert* vtx, const ImVec2& p, const ImVec2& dm, unsigned int vtx_stride, float half_inner_thickness, float aa_size, const ImVec2& uv, ImU32 col, ImU32 col_trans)
+{
+    if (vtx_stride == 2)
+    {
+        const ImVec2 dm_in = dm * half_inner_thickness;
+        ImDrawVertWrite(&vtx[0], p + dm_in, uv, col);
+        ImDrawVertWrite(&vtx[1], p - dm_in, uv, col);
+        return vtx + 2;
+    }
+    if (vtx_stride == 3)
+    {
+        const ImVec2 dm_aa = dm * aa_size;
+        ImDrawVertWrite(&vtx[0], p, uv, col);
+        ImDrawVertWrite(&vtx[1], p + dm_aa, uv, col_trans);
+        ImDrawVertWrite(&vtx[2], p - dm_aa, uv, col_trans);
+        return vtx + 3;
+    }
+    const ImVec2 dm_out = dm * (half_inner_thickness + aa_size);
+    const ImVec2 dm_in = dm * half_inner_thickness;
+    ImDrawVertWrite(&vtx[0], p + dm_out, uv, col_trans);
+    ImDrawVertWrite(&vtx[1], p + dm_in, uv, col);
+    ImDrawVertWrite(&vtx[2], p - dm_in, uv, col);
+    ImDrawVertWrite(&vtx[3], p - dm_out, uv, col_trans);
+    return vtx + 4;
+}
 
-        for (int i1 = 0; i1 < count; i1++)
+// Write the indices of the segment between the points starting at vertices idx1 and idx2
+static inline ImDrawIdx* PolylineWriteIdx(ImDrawIdx* idx, unsigned int idx1, unsigned int idx2, unsigned int vtx_stride)
+{
+    if (vtx_stride == 2)
+    {
+        idx[0] = (ImDrawIdx)(idx1+0); idx[1] = (ImDrawIdx)(idx2+0); idx[2] = (ImDrawIdx)(idx2+1);
+        idx[3] = (ImDrawIdx)(idx1+0); idx[4] = (ImDrawIdx)(idx2+1); idx[5] = (ImDrawIdx)(idx1+1);
+        return idx + 6;
+    }
+    if (vtx_stride == 3)
+    {
+        idx[0] = (ImDrawIdx)(idx2+0); idx[1] = (ImDrawIdx)(idx1+0); idx[2] = (ImDrawIdx)(idx1+2);
+        idx[3] = (ImDrawIdx)(idx1+2); idx[4] = (ImDrawIdx)(idx2+2); idx[5] = (ImDrawIdx)(idx2+0);
+        idx[6] = (ImDrawIdx)(idx2+1); idx[7] = (ImDrawIdx)(idx1+1); idx[8] = (ImDrawIdx)(idx1+0);
+        idx[9] = (ImDrawIdx)(idx1+0); idx[10]= (ImDrawIdx)(idx2+0); idx[11]= (ImDrawIdx)(idx2+1);
+        return idx + 12;
+    }
+    idx[0]  = (ImDrawIdx)(idx2+1); idx[1]  = (ImDrawIdx)(idx1+1); idx[2]  = (ImDrawIdx)(idx1+2);
+    idx[3]  = (ImDrawIdx)(idx1+2); idx[4]  = (ImDrawIdx)(idx2+2); idx[5]  = (ImDrawIdx)(idx2+1);
+    idx[6]  = (ImDrawIdx)(idx2+1); idx[7]  = (ImDrawIdx)(idx1+1); idx[8]  = (ImDrawIdx)(idx1+0);
+    idx[9]  = (ImDrawIdx)(idx1+0); idx[10] = (ImDrawIdx)(idx2+0); idx[11] = (ImDrawIdx)(idx2+1);
+    idx[12] = (ImDrawIdx)(idx2+2); idx[13] = (ImDrawIdx)(idx1+2); idx[14] = (ImDrawIdx)(idx1+3);
+    idx[15] = (ImDrawIdx)(idx1+3); idx[16] = (ImDrawIdx)(idx2+3); idx[17] = (ImDrawIdx)(idx2+2);
+    return idx + 18;
+}
+
+// Write the inner and outer vertices of a point of an anti-aliased convex polygon
+static inline ImDrawVert* PolygonWriteVtxAA(ImDrawVert* vtx, const ImVec2& p, const ImVec2& dm, const ImVec2& uv, ImU32 col, ImU32 col_trans)
+{
+    ImDrawVertWrite(&vtx[0], p - dm, uv, col);          // Inner
+    ImDrawVertWrite(&vtx[1], p + dm, uv, col_trans);    // Outer
+    return vtx + 2;
+}
+
+#ifdef IMGUI_SIMD
+// Write groups*24 indices. Index n of group g is vtx_idx + (pattern[n] + step[n] * g) * vtx_stride, with vtx_stride 1 or 2.
+static inline ImDrawIdx* PolygonWriteIdxPattern(ImDrawIdx* idx, const ImDrawIdx* pattern, const ImDrawIdx* step, unsigned int vtx_idx, unsigned int vtx_stride, int groups)
+{
+    IM_ASSERT(vtx_stride == 1 || vtx_stride == 2);
+    if (groups <= 0)
+        return idx;
+    const int idx_per_reg = 16 / (int)sizeof(ImDrawIdx);
+    const int regs = 24 / idx_per_reg;
+    const ImSimdIdx base = ImSimdSet1Idx(vtx_idx);
+    ImSimdIdx v[6], s[6];
+    for (int r = 0; r < regs; r++)
+    {
+        v[r] = ImSimdLoadIdx(pattern + r * idx_per_reg);
+        s[r] = ImSimdLoadIdx(step + r * idx_per_reg);
+        if (vtx_stride == 2)
         {
-            const int i2 = (i1+1) == points_count ? 0 : i1+1;
-            ImVec2 diff = points[i2] - points[i1];
-            diff *= ImInvLength(diff, 1.0f);
-            temp_normals[i1].x = diff.y;
-            temp_normals[i1].y = -diff.x;
+            v[r] = ImSimdAddIdx(v[r], v[r]);
+            s[r] = ImSimdAddIdx(s[r], s[r]);
         }
-        if (!closed)
-            temp_normals[points_count-1] = temp_normals[points_count-2];
-
-        if (!thick_line)
+        v[r] = ImSimdAddIdx(v[r], base);
+    }
+    for (int g = 0; g < groups; g++, idx += 24)
+        for (int r = 0; r < regs; r++)
         {
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * AA_SIZE;
-                temp_points[1] = points[0] - temp_normals[0] * AA_SIZE;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * AA_SIZE;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * AA_SIZE;
-            }
-
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx;
-            for (int i1 = 0; i1 < count; i1++)
-            {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
-                unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+3;
+            ImSimdStoreIdx(idx + r * idx_per_reg, v[r]);
+            v[r] = ImSimdAddIdx(v[r], s[r]);
+        }
+    return idx;
+}
+#endif
 
-                // Average normals
-                ImVec2 dm = (temp_normals[i1] + temp_normals[i2]) * 0.5f;
-                float dmr2 = dm.x*dm.x + dm.y*dm.y;
-                if (dmr2 > 0.000001f)
-                {
-                    float scale = 1.0f / dmr2;
-                    if (scale > 100.0f) scale = 100.0f;
-                    dm *= scale;
-                }
-                dm *= AA_SIZE;
-                temp_points[i2*2+0] = points[i2] + dm;
-                temp_points[i2*2+1] = points[i2] - dm;
-
-                // Add indexes
-                _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
-                _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
-                _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
-                _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
-                _IdxWritePtr += 12;
-
-                idx1 = idx2;
-            }
+// Write the indices of the triangle fan of a convex polygon, whose points are vtx_stride vertices apart starting at vtx_idx
+static inline ImDrawIdx* PolygonWriteFanIdx(ImDrawIdx* idx, unsigned int vtx_idx, int points_count, unsigned int vtx_stride)
+{
+    int i = 2;
+#ifdef IMGUI_SIMD
+    // 8 triangles per group
+    static const ImDrawIdx pattern[24] = { 0,1,2, 0,2,3, 0,3,4, 0,4,5, 0,5,6, 0,6,7, 0,7,8, 0,8,9 };
+    static const ImDrawIdx step[24] = { 0,8,8, 0,8,8, 0,8,8, 0,8,8, 0,8,8, 0,8,8, 0,8,8, 0,8,8 };
+    const int groups = (points_count - 2) / 8;
+    idx = PolygonWriteIdxPattern(idx, pattern, step, vtx_idx, vtx_stride, groups);
+    i += groups * 8;
+#endif
+    for (; i < points_count; i++)
+    {
+        idx[0] = (ImDrawIdx)(vtx_idx); idx[1] = (ImDrawIdx)(vtx_idx+(i-1)*vtx_stride); idx[2] = (ImDrawIdx)(vtx_idx+i*vtx_stride);
+        idx += 3;
+    }
+    return idx;
+}
 
-            // Add vertexes
-            for (int i = 0; i < points_count; i++)
-            {
-                _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-                _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
-                _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
-                _VtxWritePtr += 3;
-            }
-        }
-        else
-        {
-            const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+0] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+1] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+2] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+3] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
-            }
+// Write the indices of the fringe of the edge between points i0 and i1 of an anti-aliased convex polygon, whose points have an inner and an outer vertex starting at vtx_idx
+static inline ImDrawIdx* PolygonWriteFringeEdgeIdx(ImDrawIdx* idx, unsigned int vtx_idx, int i0, int i1)
+{
+    const unsigned int inner0 = vtx_idx+(i0<<1), inner1 = vtx_idx+(i1<<1);
+    idx[0] = (ImDrawIdx)(inner1);   idx[1] = (ImDrawIdx)(inner0);   idx[2] = (ImDrawIdx)(inner0+1);
+    idx[3] = (ImDrawIdx)(inner0+1); idx[4] = (ImDrawIdx)(inner1+1); idx[5] = (ImDrawIdx)(inner1);
+    return idx + 6;
+}
 
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx;
-            for (int i1 = 0; i1 < count; i1++)
-            {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
-                unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+4;
+// Write the indices of the fringe of all the edges of an anti-aliased convex polygon, starting with the closing edge
+static inline ImDrawIdx* PolygonWriteFringeIdx(ImDrawIdx* idx, unsigned int vtx_idx, int points_count)
+{
+    idx = PolygonWriteFringeEdgeIdx(idx, vtx_idx, points_count-1, 0);
+    int i1 = 1;
+#ifdef IMGUI_SIMD
+    // 4 edges per group
+    static const ImDrawIdx pattern[24] = { 2,0,1, 1,3,2, 4,2,3, 3,5,4, 6,4,5, 5,7,6, 8,6,7, 7,9,8 };
+    static const ImDrawIdx step[24] = { 8,8,8, 8,8,8, 8,8,8, 8,8,8, 8,8,8, 8,8,8, 8,8,8, 8,8,8 };
+    const int groups = (points_count - 1) / 4;
+    idx = PolygonWriteIdxPattern(idx, pattern, step, vtx_idx, 1, groups);
+    i1 += groups * 4;
+#endif
+    for (; i1 < points_count; i1++)
+        idx = PolygonWriteFringeEdgeIdx(idx, vtx_idx, i1-1, i1);
+    return idx;
+}
 
-                // Average normals
-                ImVec2 dm = (temp_normals[i1] + temp_normals[i2]) * 0.5f;
-                float dmr2 = dm.x*dm.x + dm.y*dm.y;
-                if (dmr2 > 0.000001f)
-                {
-                    float scale = 1.0f / dmr2;
-                    if (scale > 100.0f) scale = 100.0f;
-                    dm *= scale;
-                }
-                ImVec2 dm_out = dm * (half_inner_thickness + AA_SIZE);
-                ImVec2 dm_in = dm * half_inner_thickness;
-                temp_points[i2*4+0] = points[i2] + dm_out;
-                temp_points[i2*4+1] = points[i2] + dm_in;
-                temp_points[i2*4+2] = points[i2] - dm_in;
-                temp_points[i2*4+3] = points[i2] - dm_out;
-
-                // Add indexes
-                _IdxWritePtr[0]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1+2);
-                _IdxWritePtr[3]  = (ImDrawIdx)(idx1+2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2+2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2+1);
-                _IdxWritePtr[6]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1+0);
-                _IdxWritePtr[9]  = (ImDrawIdx)(idx1+0); _IdxWritePtr[10] = (ImDrawIdx)(idx2+0); _IdxWritePtr[11] = (ImDrawIdx)(idx2+1);
-                _IdxWritePtr[12] = (ImDrawIdx)(idx2+2); _IdxWritePtr[13] = (ImDrawIdx)(idx1+2); _IdxWritePtr[14] = (ImDrawIdx)(idx1+3);
-                _IdxWritePtr[15] = (ImDrawIdx)(idx1+3); _IdxWritePtr[16] = (ImDrawIdx)(idx2+3); _IdxWritePtr[17] = (ImDrawIdx)(idx2+2);
-                _IdxWritePtr += 18;
-
-                idx1 = idx2;
-            }
+// ImDrawList::CpuCulling: return true if a primitive within the bounding box would be entirely scissored away
+static inline bool CullRect(ImDrawList* draw_list, const ImVec2& local_bb_min, const ImVec2& local_bb_max)
+{
+    const ImVec4& clip_rect = draw_list->_ClipRectStack.Size ? draw_list->_ClipRectStack.back() : GNullClipRect;
+    ImVec2 bb_min = local_bb_min, bb_max = local_bb_max;
+    if (draw_list->_TransformStack.Size > 0)
+    {
+        const ImRect bb = ImDrawCmdTransformRect(draw_list->_TransformStack.back(), ImRect(local_bb_min, local_bb_max));
+        bb_min = bb.Min;
+        bb_max = bb.Max;
+    }
+    if (bb_max.x >= clip_rect.x && bb_max.y >= clip_rect.y && bb_min.x <= clip_rect.z && bb_min.y <= clip_rect.w)
+        return false;
+    draw_list->_CulledCount++;
+    return true;
+}
 
-            // Add vertexes
-            for (int i = 0; i < points_count; i++)
-            {
-                _VtxWritePtr[0].pos = temp_points[i*4+0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i*4+1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i*4+2]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i*4+3]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
-            }
-        }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+static bool CullPoints(ImDrawList* draw_list, const ImVec2* points, const int points_count, float expand)
+{
+    ImVec2 bb_min = points[0], bb_max = points[0];
+    for (int i = 1; i < points_count; i++)
+    {
+        bb_min = ImMin(bb_min, points[i]);
+        bb_max = ImMax(bb_max, points[i]);
     }
-    else
+    return CullRect(draw_list, bb_min - ImVec2(expand, expand), bb_max + ImVec2(expand, expand));
+}
+
+// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
+void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness, bool anti_aliased)
+{
+    if (points_count < 2)
+        return;
+    if (CpuCulling && CullPoints(this, points, points_count, thickness * 0.5f + 1.0f))
+        return;
+
+    if (_CacheState >= 2)
     {
-        // Non Anti-aliased Stroke
-        const int idx_count = count*6;
-        const int vtx_count = count*4;      // FIXME-OPT: Not sharing edges
-        PrimReserve(idx_count, vtx_count);
+        ImDrawListCacheKey key(ImDrawListCacheCall_Polyline);
+        key.Add(ImHash(points, points_count * (int)sizeof(ImVec2), 0));
+        key.Add((ImU32)points_count);
+        key.Add(col);
+        key.Add((ImU32)closed | ((ImU32)anti_aliased << 1));
+        key.Add(thickness);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), true))
+            return;
+    }
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    anti_aliased &= _Data->AntiAliasedLines;
+    //if (ImGui::GetIO().KeyCtrl) anti_aliased = false; // Debug
+
+    int count = points_count;
+    if (!closed)
+        count = points_count-1;
 
-        for (int i1 = 0; i1 < count; i1++)
+    // Anti-aliased strokes have a transparent fringe of AA_SIZE on each side. Thin strokes only have the center vertex.
+    const float AA_SIZE = 1.0f;
+    const ImU32 col_trans = col & 0x00ffffff;
+    const unsigned int vtx_stride = !anti_aliased ? 2 : (thickness > 1.0f) ? 4 : 3;
+    const float half_inner_thickness = anti_aliased ? (thickness - AA_SIZE) * 0.5f : thickness * 0.5f;
+
+    const int idx_count = count * (int)(vtx_stride - 1) * 6;
+    const int vtx_count = points_count * (int)vtx_stride;
+    PrimReserve(idx_count, vtx_count);
+    const unsigned int idx_base = _VtxCurrentIdx;
+
+    // First point. The first point of an open line uses the normal of the first segment as-is.
+    ImVec2 n_prev = PolylineSegmentNormal(points[0], points[1]);
+    const ImVec2 dm0 = closed ? PolylineJoinNormal(PolylineSegmentNormal(points[points_count-1], points[0]), n_prev) : n_prev;
+    _VtxWritePtr = PolylineWriteVtx(_VtxWritePtr, points[0], dm0, vtx_stride, half_inner_thickness, AA_SIZE, uv, col, col_trans);
+
+    int i = 1;
+#ifdef IMGUI_SIMD
+    // 4 points at a time, as long as the 4 following segments are within the array
+    for (; i + 4 < points_count; i += 4)
+    {
+        float out_dmx[4], out_dmy[4];
+        PolylineJoinNormals4(points + i, &n_prev, out_dmx, out_dmy);
+        for (int n = 0; n < 4; n++)
         {
-            const int i2 = (i1+1) == points_count ? 0 : i1+1;
-            const ImVec2& p1 = points[i1];
-            const ImVec2& p2 = points[i2];
-            ImVec2 diff = p2 - p1;
-            diff *= ImInvLength(diff, 1.0f);
-
-            const float dx = diff.x * (thickness * 0.5f);
-            const float dy = diff.y * (thickness * 0.5f);
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
-            _VtxWritePtr += 4;
-
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
-            _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx+2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx+3);
-            _IdxWritePtr += 6;
-            _VtxCurrentIdx += 4;
+            _VtxWritePtr = PolylineWriteVtx(_VtxWritePtr, points[i+n], ImVec2(out_dmx[n], out_dmy[n]), vtx_stride, half_inner_thickness, AA_SIZE, uv, col, col_trans);
+            const unsigned int idx1 = idx_base + (unsigned int)(i+n-1) * vtx_stride;
+            _IdxWritePtr = PolylineWriteIdx(_IdxWritePtr, idx1, idx1 + vtx_stride, vtx_stride);
         }
     }
+#endif
+    for (; i < points_count; i++)
+    {
+        // The last point of an open line only has the normal of the previous segment
+        ImVec2 n;
+        if (i + 1 < points_count)
+            n = PolylineSegmentNormal(points[i], points[i+1]);
+        else
+            n = closed ? PolylineSegmentNormal(points[i], points[0]) : n_prev;
+        _VtxWritePtr = PolylineWriteVtx(_VtxWritePtr, points[i], PolylineJoinNormal(n_prev, n), vtx_stride, half_inner_thickness, AA_SIZE, uv, col, col_trans);
+        const unsigned int idx1 = idx_base + (unsigned int)(i-1) * vtx_stride;
+        _IdxWritePtr = PolylineWriteIdx(_IdxWritePtr, idx1, idx1 + vtx_stride, vtx_stride);
+        n_prev = n;
+    }
+    if (closed)
+        _IdxWritePtr = PolylineWriteIdx(_IdxWritePtr, idx_base + (unsigned int)(points_count-1) * vtx_stride, idx_base, vtx_stride);
+    _VtxCurrentIdx += (ImDrawIdx)vtx_count;
 }
 
 void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col, bool anti_aliased)
 {
-    const ImVec2 uv = GImGui->FontTexUvWhitePixel;
-    anti_aliased &= GImGui->Style.AntiAliasedShapes;
+    if (points_count < 3)
+        return;
+    if (CpuCulling && CullPoints(this, points, points_count, 1.0f))
+        return;
+
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_ConvexPolyFilled);
+        key.Add(points_count > 0 ? ImHash(points, points_count * (int)sizeof(ImVec2), 0) : 0);
+        key.Add((ImU32)points_count);
+        key.Add(col);
+        key.Add((ImU32)anti_aliased);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), true))
+            return;
+    }
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    anti_aliased &= _Data->AntiAliasedShapes;
     //if (ImGui::GetIO().KeyCtrl) anti_aliased = false; // Debug
 
     if (anti_aliased)
@@ -547,50 +1263,41 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         PrimReserve(idx_count, vtx_count);
 
         // Add indexes for fill
-        unsigned int vtx_inner_idx = _VtxCurrentIdx;
-        unsigned int vtx_outer_idx = _VtxCurrentIdx+1;
-        for (int i = 2; i < points_count; i++)
-        {
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+((i-1)<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx+(i<<1));
-            _IdxWritePtr += 3;
-        }
+        _IdxWritePtr = PolygonWriteFanIdx(_IdxWritePtr, _VtxCurrentIdx, points_count, 2);
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2));
-        for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+        // Add vertices and indexes for fringes. The normal of each edge is averaged with the normal of the previous edge (the closing edge for point 0).
+#ifdef IMGUI_SIMD
+        if (points_count >= 24)
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            ImVec2 diff = p1 - p0;
-            diff *= ImInvLength(diff, 1.0f);
-            temp_normals[i0].x = diff.y;
-            temp_normals[i0].y = -diff.x;
+            _IdxWritePtr = PolygonWriteFringeIdx(_IdxWritePtr, _VtxCurrentIdx, points_count);
+
+            // Compute the join normals in a single pass, 4 points at a time. The last 1-4 points are read from a copy, with the following points wrapping around.
+            // Vertices are written in a separate loop: interleaving the scalar vertex stores with the SIMD computations is slower.
+            const int points_count_4 = (points_count + 3) & ~3;
+            float* dm_x = (float*)alloca(points_count_4 * 2 * sizeof(float));
+            float* dm_y = dm_x + points_count_4;
+            ImVec2 n_prev = PolylineSegmentNormal(points[points_count-1], points[0]);
+            int i = 0;
+            for (; i + 4 < points_count; i += 4)
+                PolylineJoinNormals4(points + i, &n_prev, dm_x + i, dm_y + i);
+            ImVec2 wrap_points[5];
+            for (int n = 0; n < 5; n++)
+                wrap_points[n] = points[(i + n < points_count) ? i + n : i + n - points_count];
+            PolylineJoinNormals4(wrap_points, &n_prev, dm_x + i, dm_y + i);
+            for (i = 0; i < points_count; i++)
+                _VtxWritePtr = PolygonWriteVtxAA(_VtxWritePtr, points[i], ImVec2(dm_x[i], dm_y[i]) * (AA_SIZE * 0.5f), uv, col, col_trans);
         }
-
-        for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+        else
+#endif
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            ImVec2 dm = (n0 + n1) * 0.5f;
-            float dmr2 = dm.x*dm.x + dm.y*dm.y;
-            if (dmr2 > 0.000001f)
+            ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2));
+            for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+                temp_normals[i0] = PolylineSegmentNormal(points[i0], points[i1]);
+            for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
             {
-                float scale = 1.0f / dmr2;
-                if (scale > 100.0f) scale = 100.0f;
-                dm *= scale;
+                _VtxWritePtr = PolygonWriteVtxAA(_VtxWritePtr, points[i1], PolylineJoinNormal(temp_normals[i0], temp_normals[i1]) * (AA_SIZE * 0.5f), uv, col, col_trans);
+                _IdxWritePtr = PolygonWriteFringeEdgeIdx(_IdxWritePtr, _VtxCurrentIdx, i0, i1);
             }
-            dm *= AA_SIZE * 0.5f;
-
-            // Add vertices
-            _VtxWritePtr[0].pos = (points[i1] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos = (points[i1] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
-            _IdxWritePtr += 6;
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
@@ -602,34 +1309,57 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            ImDrawVertWrite(&_VtxWritePtr[0], points[i], uv, col);
             _VtxWritePtr++;
         }
-        for (int i = 2; i < points_count; i++)
-        {
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+i-1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+i);
-            _IdxWritePtr += 3;
-        }
+        _IdxWritePtr = PolygonWriteFanIdx(_IdxWritePtr, _VtxCurrentIdx, points_count, 1);
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
 }
 
-void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int amax)
+// Unit circle sampled every half degree. Arcs and circles read it with a stride (a segment count which divides IM_DRAWLIST_CIRCLE_TABLE_SIZE), so they need no trigonometry.
+// Built during static initialization rather than on first use, so that draw lists of different contexts can be filled from multiple threads.
+#define IM_DRAWLIST_CIRCLE_TABLE_SIZE   720
+struct ImDrawListCircleTable
 {
-    static ImVec2 circle_vtx[12];
-    static bool circle_vtx_builds = false;
-    const int circle_vtx_count = IM_ARRAYSIZE(circle_vtx);
-    if (!circle_vtx_builds)
+    ImVec2 Vtx[IM_DRAWLIST_CIRCLE_TABLE_SIZE];
+    ImDrawListCircleTable()
     {
-        for (int i = 0; i < circle_vtx_count; i++)
+        for (int i = 0; i < IM_ARRAYSIZE(Vtx); i++)
         {
-            const float a = ((float)i / (float)circle_vtx_count) * 2*IM_PI;
-            circle_vtx[i].x = cosf(a);
-            circle_vtx[i].y = sinf(a);
+            const float a = ((float)i / (float)IM_ARRAYSIZE(Vtx)) * 2*IM_PI;
+            Vtx[i].x = cosf(a);
+            Vtx[i].y = sinf(a);
         }
-        circle_vtx_builds = true;
     }
+};
+static ImDrawListCircleTable GCircleTable;
+
+// Segment counts of a full circle which divide IM_DRAWLIST_CIRCLE_TABLE_SIZE, in increasing order
+static const short GCircleSegmentCounts[] = { 4, 5, 6, 8, 9, 10, 12, 15, 16, 18, 20, 24, 30, 36, 40, 45, 48, 60, 72, 80, 90, 120, 144, 180, 240, 360, 720 };
+
+// Maximum distance between a curve and its tessellation, in pixels (0.31 with the default tolerance).
+static inline float GetCurveTessellationMaxError(const ImDrawListSharedData* data)
+{
+    return data->CurveTessellationTol * 0.25f;
+}
 
+// Step in GCircleTable to tessellate an arc of 'span' table entries, so that the distance between the arc and its segments stays under the tessellation error.
+// The step divides span, so both ends of the arc fall on a table entry.
+static int GetCircleTableStep(const ImDrawListSharedData* data, float radius, int span)
+{
+    // The sagitta of a segment of a circle tessellated with n segments is radius*(1-cos(PI/n)) <= radius*(PI/n)^2/2
+    const float n = (radius > 0.0f) ? IM_PI * sqrtf(radius / (2.0f * GetCurveTessellationMaxError(data))) : 0.0f;
+    int i = 0;
+    while (i < IM_ARRAYSIZE(GCircleSegmentCounts)-1 && (float)GCircleSegmentCounts[i] < n)
+        i++;
+    while (span % (IM_DRAWLIST_CIRCLE_TABLE_SIZE / GCircleSegmentCounts[i]) != 0)
+        i++;
+    return IM_DRAWLIST_CIRCLE_TABLE_SIZE / GCircleSegmentCounts[i];
+}
+
+void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int amax)
+{
     if (amin > amax) return;
     if (radius == 0.0f)
     {
@@ -637,10 +1367,14 @@ void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int
     }
     else
     {
-        _Path.reserve(_Path.Size + (amax - amin + 1));
-        for (int a = amin; a <= amax; a++)
+        // Angles are given in 12th of a circle
+        const int table_amin = amin * (IM_DRAWLIST_CIRCLE_TABLE_SIZE / 12);
+        const int table_amax = amax * (IM_DRAWLIST_CIRCLE_TABLE_SIZE / 12);
+        const int step = GetCircleTableStep(_Data, radius, table_amax - table_amin);
+        _Path.reserve(_Path.Size + (table_amax - table_amin) / step + 1);
+        for (int a = table_amin; a <= table_amax; a += step)
         {
-            const ImVec2& c = circle_vtx[a % circle_vtx_count];
+            const ImVec2& c = GCircleTable.Vtx[a % IM_DRAWLIST_CIRCLE_TABLE_SIZE];
             _Path.push_back(ImVec2(centre.x + c.x * radius, centre.y + c.y * radius));
         }
     }
@@ -658,54 +1392,54 @@ void ImDrawList::PathArcTo(const ImVec2& centre, float radius, float amin, float
     }
 }
 
-static void PathBezierToCasteljau(ImVector<ImVec2>* path, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, float tess_tol, int level)
+// Add the points of a full circle to the path. 0 segments: automatic segment count.
+static void PathCircle(ImDrawList* draw_list, const ImVec2& centre, float radius, int num_segments)
 {
-    float dx = x4 - x1;
-    float dy = y4 - y1;
-    float d2 = ((x2 - x4) * dy - (y2 - y4) * dx); 
-    float d3 = ((x3 - x4) * dy - (y3 - y4) * dx); 
-    d2 = (d2 >= 0) ? d2 : -d2;
-    d3 = (d3 >= 0) ? d3 : -d3;
-    if ((d2+d3) * (d2+d3) < tess_tol * (dx*dx + dy*dy)) 
+    if (num_segments > 0 && (IM_DRAWLIST_CIRCLE_TABLE_SIZE % num_segments) != 0)
     {
-        path->push_back(ImVec2(x4, y4));
+        draw_list->PathArcTo(centre, radius, 0.0f, IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments, num_segments - 1);
+        return;
     }
-    else if (level < 10)
+    const int step = (num_segments > 0) ? IM_DRAWLIST_CIRCLE_TABLE_SIZE / num_segments : GetCircleTableStep(draw_list->_Data, radius, IM_DRAWLIST_CIRCLE_TABLE_SIZE);
+    ImVector<ImVec2>& path = draw_list->_Path;
+    path.reserve(path.Size + IM_DRAWLIST_CIRCLE_TABLE_SIZE / step);
+    for (int a = 0; a < IM_DRAWLIST_CIRCLE_TABLE_SIZE; a += step)
     {
-        float x12 = (x1+x2)*0.5f,       y12 = (y1+y2)*0.5f;
-        float x23 = (x2+x3)*0.5f,       y23 = (y2+y3)*0.5f;
-        float x34 = (x3+x4)*0.5f,       y34 = (y3+y4)*0.5f;
-        float x123 = (x12+x23)*0.5f,    y123 = (y12+y23)*0.5f;
-        float x234 = (x23+x34)*0.5f,    y234 = (y23+y34)*0.5f;
-        float x1234 = (x123+x234)*0.5f, y1234 = (y123+y234)*0.5f;
-
-        PathBezierToCasteljau(path, x1,y1,        x12,y12,    x123,y123,  x1234,y1234, tess_tol, level+1); 
-        PathBezierToCasteljau(path, x1234,y1234,  x234,y234,  x34,y34,    x4,y4,       tess_tol, level+1); 
+        const ImVec2& c = GCircleTable.Vtx[a];
+        path.push_back(ImVec2(centre.x + c.x * radius, centre.y + c.y * radius));
     }
 }
 
 void ImDrawList::PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
 {
-    ImVec2 p1 = _Path.back();
+    const ImVec2 p1 = _Path.back();
     if (num_segments == 0)
     {
-        // Auto-tessellated
-        PathBezierToCasteljau(&_Path, p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, p4.x, p4.y, GImGui->Style.CurveTessellationTol, 0);
+        // Auto-tessellated. With uniform subdivision the distance between the curve and its segments is at most max|B''|/(8*num_segments^2),
+        // and the second derivative of a cubic Bezier is bounded by 6*max(|p1-2*p2+p3|, |p2-2*p3+p4|).
+        const float dd = sqrtf(ImMax(ImLengthSqr(p1 - p2*2.0f + p3), ImLengthSqr(p2 - p3*2.0f + p4)));
+        num_segments = (int)ceilf(sqrtf(0.75f * dd / GetCurveTessellationMaxError(_Data)));
+        num_segments = ImClamp(num_segments, 1, 1024);
     }
-    else
+
+    // Forward differencing of B(t) = a*t^3 + b*t^2 + c*t + p1, with a constant step h
+    const float h = 1.0f / (float)num_segments;
+    const ImVec2 a = (p2 - p3) * 3.0f + p4 - p1;
+    const ImVec2 b = (p1 - p2*2.0f + p3) * 3.0f;
+    const ImVec2 c = (p2 - p1) * 3.0f;
+    ImVec2 f = p1;
+    ImVec2 df = a * (h*h*h) + b * (h*h) + c * h;
+    ImVec2 ddf = a * (6.0f*h*h*h) + b * (2.0f*h*h);
+    const ImVec2 dddf = a * (6.0f*h*h*h);
+    _Path.reserve(_Path.Size + num_segments);
+    for (int i_step = 1; i_step < num_segments; i_step++)
     {
-        float t_step = 1.0f / (float)num_segments;
-        for (int i_step = 1; i_step <= num_segments; i_step++)
-        {
-            float t = t_step * i_step;
-            float u = 1.0f - t;
-            float w1 = u*u*u;
-            float w2 = 3*u*u*t;
-            float w3 = 3*u*t*t;
-            float w4 = t*t*t;
-            _Path.push_back(ImVec2(w1*p1.x + w2*p2.x + w3*p3.x + w4*p4.x, w1*p1.y + w2*p2.y + w3*p3.y + w4*p4.y));
-        }
+        f += df;
+        df += ddf;
+        ddf += dddf;
+        _Path.push_back(f);
     }
+    _Path.push_back(p4);
 }
 
 void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, int rounding_corners)
@@ -738,6 +1472,8 @@ void ImDrawList::AddLine(const ImVec2& a, const ImVec2& b, ImU32 col, float thic
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, ImMin(a, b) - ImVec2(thickness, thickness), ImMax(a, b) + ImVec2(thickness + 1.0f, thickness + 1.0f)))
+        return;
     PathLineTo(a + ImVec2(0.5f,0.5f));
     PathLineTo(b + ImVec2(0.5f,0.5f));
     PathStroke(col, false, thickness);
@@ -747,6 +1483,8 @@ void ImDrawList::AddRect(const ImVec2& a, const ImVec2& b, ImU32 col, float roun
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, a - ImVec2(1.0f, 1.0f), b + ImVec2(2.0f, 2.0f)))
+        return;
     PathRect(a + ImVec2(0.5f,0.5f), b + ImVec2(0.5f,0.5f), rounding, rounding_corners);
     PathStroke(col, true);
 }
@@ -755,6 +1493,8 @@ void ImDrawList::AddRectFilled(const ImVec2& a, const ImVec2& b, ImU32 col, floa
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, a - ImVec2(1.0f, 1.0f), b + ImVec2(1.0f, 1.0f)))
+        return;
     if (rounding > 0.0f)
     {
         PathRect(a, b, rounding, rounding_corners);
@@ -762,6 +1502,15 @@ void ImDrawList::AddRectFilled(const ImVec2& a, const ImVec2& b, ImU32 col, floa
     }
     else
     {
+        if (_CacheState >= 2)
+        {
+            ImDrawListCacheKey key(ImDrawListCacheCall_RectFilled);
+            key.Add(a);
+            key.Add(b);
+            key.Add(col);
+            if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), true))
+                return;
+        }
         PrimReserve(6, 4);
         PrimRect(a, b, col);
     }
@@ -771,8 +1520,23 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& a, const ImVec2& c, ImU32
 {
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, a, c))
+        return;
+
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_RectFilledMultiColor);
+        key.Add(a);
+        key.Add(c);
+        key.Add(col_upr_left);
+        key.Add(col_upr_right);
+        key.Add(col_bot_right);
+        key.Add(col_bot_left);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), true))
+            return;
+    }
 
-    const ImVec2 uv = GImGui->FontTexUvWhitePixel;
+    const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
     PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx)); PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx+1)); PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx+2));
     PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx)); PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx+2)); PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx+3));
@@ -786,6 +1550,8 @@ void ImDrawList::AddTriangleFilled(const ImVec2& a, const ImVec2& b, const ImVec
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, ImMin(ImMin(a, b), c) - ImVec2(1.0f, 1.0f), ImMax(ImMax(a, b), c) + ImVec2(1.0f, 1.0f)))
+        return;
 
     PathLineTo(a);
     PathLineTo(b);
@@ -797,9 +1563,10 @@ void ImDrawList::AddCircle(const ImVec2& centre, float radius, ImU32 col, int nu
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, centre - ImVec2(radius + 1.0f, radius + 1.0f), centre + ImVec2(radius + 1.0f, radius + 1.0f)))
+        return;
 
-    const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
-    PathArcTo(centre, radius, 0.0f, a_max, num_segments);
+    PathCircle(this, centre, radius, num_segments);
     PathStroke(col, true);
 }
 
@@ -807,9 +1574,10 @@ void ImDrawList::AddCircleFilled(const ImVec2& centre, float radius, ImU32 col,
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, centre - ImVec2(radius + 1.0f, radius + 1.0f), centre + ImVec2(radius + 1.0f, radius + 1.0f)))
+        return;
 
-    const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
-    PathArcTo(centre, radius, 0.0f, a_max, num_segments);
+    PathCircle(this, centre, radius, num_segments);
     PathFill(col);
 }
 
@@ -817,6 +1585,13 @@ void ImDrawList::AddBezierCurve(const ImVec2& pos0, const ImVec2& cp0, const ImV
 { 
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling)
+    {
+        // The curve is contained in the convex hull of its control points
+        const ImVec2 hull[4] = { pos0, cp0, cp1, pos1 };
+        if (CullPoints(this, hull, 4, thickness * 0.5f + 1.0f))
+            return;
+    }
 
     PathLineTo(pos0); 
     PathBezierCurveTo(cp0, cp1, pos1, num_segments); 
@@ -835,15 +1610,52 @@ void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos,
 
     IM_ASSERT(font->ContainerAtlas->TexID == _TextureIdStack.back());  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
 
+    if (CpuCulling)
+    {
+        // Text extends right and down from 'pos': only measure it when it starts above or left of the clip rect (or under a transform, where it may extend anywhere on screen).
+        // Glyphs may overhang their advance a little, so the tests include a margin.
+        const ImVec4& clip_rect = _ClipRectStack.back();
+        const ImVec2 margin(2.0f, 2.0f);
+        const bool transformed = _TransformStack.Size > 0;
+        if (!transformed && (pos.x - margin.x > clip_rect.z || pos.y - margin.y > clip_rect.w))
+        {
+            _CulledCount++;
+            return;
+        }
+        if (transformed || pos.x < clip_rect.x || pos.y + font_size < clip_rect.y)
+        {
+            const ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text_begin, text_end, NULL);
+            if (CullRect(this, pos - margin, pos + text_size + margin))
+                return;
+        }
+    }
+
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_Text);
+        key.Add(ImHash(text_begin, (int)(text_end - text_begin), 0));
+        key.Add((ImU32)(text_end - text_begin));
+        key.Add((const void*)font);
+        key.Add(font_size);
+        key.Add(pos);
+        key.Add(col);
+        key.Add(wrap_width);
+        if (cpu_fine_clip_rect)
+            key.Add(*cpu_fine_clip_rect);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), true))
+            return;
+    }
+
     // reserve vertices for worse case (over-reserving is useful and easily amortized)
     const int char_count = (int)(text_end - text_begin);
     const int vtx_count_max = char_count * 4;
     const int idx_count_max = char_count * 6;
-    const int vtx_begin = VtxBuffer.Size;
-    const int idx_begin = IdxBuffer.Size;
     PrimReserve(idx_count_max, vtx_count_max);
+    const ImDrawVert* vtx_begin = _VtxWritePtr;
+    const ImDrawIdx* idx_begin = _IdxWritePtr;
 
-    ImVec4 clip_rect = _ClipRectStack.back();
+    // The clip rect is in screen space: under a transform, only 'cpu_fine_clip_rect' (in local space) is applied on the CPU
+    ImVec4 clip_rect = _TransformStack.Size ? ImVec4(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX) : _ClipRectStack.back();
     if (cpu_fine_clip_rect)
     {
         clip_rect.x = ImMax(clip_rect.x, cpu_fine_clip_rect->x);
@@ -854,41 +1666,67 @@ void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos,
     font->RenderText(font_size, pos, col, clip_rect, text_begin, text_end, this, wrap_width, cpu_fine_clip_rect != NULL);
 
     // give back unused vertices
-    // FIXME-OPT: clean this up
-    VtxBuffer.resize((int)(_VtxWritePtr - VtxBuffer.Data));
-    IdxBuffer.resize((int)(_IdxWritePtr - IdxBuffer.Data));
-    int vtx_unused = vtx_count_max - (VtxBuffer.Size - vtx_begin);
-    int idx_unused = idx_count_max - (IdxBuffer.Size - idx_begin);
+    const int vtx_unused = vtx_count_max - (int)(_VtxWritePtr - vtx_begin);
+    const int idx_unused = idx_count_max - (int)(_IdxWritePtr - idx_begin);
+    VtxBuffer.resize(VtxBuffer.Size - vtx_unused);
+    if (_ChannelsCount > 1)
+    {
+        _Channels[_ChannelsCurrent].IdxWrite -= idx_unused;
+        _Channels[_ChannelsCurrent].IdxCount -= idx_unused;
+    }
+    else
+    {
+        IdxBuffer.resize(IdxBuffer.Size - idx_unused);
+    }
     CmdBuffer.back().ElemCount -= idx_unused;
-    _VtxWritePtr -= vtx_unused;
-    _IdxWritePtr -= idx_unused;
-    _VtxCurrentIdx = (ImDrawIdx)VtxBuffer.Size;
+    _VtxCurrentIdx = (unsigned int)VtxBuffer.Size - _VtxCurrentOffset;
 }
 
-// This is one of the few function breaking the encapsulation of ImDrawLst, but it is just so useful.
 void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end)
 {
     if ((col >> 24) == 0)
         return;
 
-    AddText(GImGui->Font, GImGui->FontSize, pos, col, text_begin, text_end);
+    AddText(_Data->Font, _Data->FontSize, pos, col, text_begin, text_end);
 }
 
 void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& a, const ImVec2& b, const ImVec2& uv0, const ImVec2& uv1, ImU32 col)
 {
     if ((col >> 24) == 0)
         return;
+    if (CpuCulling && CullRect(this, a, b))
+        return;
+
+    if (_CacheState >= 2)
+    {
+        ImDrawListCacheKey key(ImDrawListCacheCall_Image);
+        key.Add((const void*)user_texture_id);
+        key.Add(a);
+        key.Add(b);
+        key.Add(uv0);
+        key.Add(uv1);
+        key.Add(col);
+        if (CacheReplayCall(key.Data, key.Size * sizeof(ImU32), true))
+            return;
+    }
 
     // FIXME-OPT: This is wasting draw calls.
+    // NB: not using PushTextureID()/PopTextureID() which would be hashed as separate calls.
     const bool push_texture_id = _TextureIdStack.empty() || user_texture_id != _TextureIdStack.back();
     if (push_texture_id)
-        PushTextureID(user_texture_id);
+    {
+        _TextureIdStack.push_back(user_texture_id);
+        UpdateTextureID();
+    }
 
     PrimReserve(6, 4);
     PrimRectUV(a, b, uv0, uv1, col);
 
     if (push_texture_id)
-        PopTextureID();
+    {
+        _TextureIdStack.pop_back();
+        UpdateTextureID();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -906,14 +1744,44 @@ void ImDrawData::DeIndexAllBuffers()
         if (cmd_list->IdxBuffer.empty())
             continue;
         new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
-        for (int j = 0; j < cmd_list->IdxBuffer.Size; j++)
-            new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
+        int vtx_offset = 0;
+        for (ImDrawCmd* pcmd = cmd_list->CmdBuffer.begin(); pcmd != cmd_list->CmdBuffer.end(); vtx_offset += pcmd->ElemCount, pcmd++)
+        {
+            // Vertices are written in command order, so pcmd->IdxOffset becomes the start of the command in the new vertex buffer
+            for (unsigned int j = 0; j < pcmd->ElemCount; j++)
+                new_vtx_buffer[vtx_offset + j] = cmd_list->VtxBuffer[pcmd->VtxOffset + cmd_list->IdxBuffer[pcmd->IdxOffset + j]];
+            pcmd->VtxOffset = 0;
+            pcmd->IdxOffset = (unsigned int)vtx_offset;
+        }
+        new_vtx_buffer.resize(vtx_offset);
         cmd_list->VtxBuffer.swap(new_vtx_buffer);
         cmd_list->IdxBuffer.resize(0);
         TotalVtxCount += cmd_list->VtxBuffer.Size;
     }
 }
 
+void ImDrawData::ConsolidateBuffers()
+{
+    CmdListsVtxOffset.resize(CmdListsCount);
+    CmdListsIdxOffset.resize(CmdListsCount);
+    TotalVtxCount = TotalIdxCount = 0;
+    for (int i = 0; i < CmdListsCount; i++)
+    {
+        CmdListsVtxOffset[i] = TotalVtxCount;
+        CmdListsIdxOffset[i] = TotalIdxCount;
+        TotalVtxCount += CmdLists[i]->VtxBuffer.Size;
+        TotalIdxCount += CmdLists[i]->IdxBuffer.Size;
+    }
+    VtxBuffer.resize(TotalVtxCount);
+    IdxBuffer.resize(TotalIdxCount);
+    for (int i = 0; i < CmdListsCount; i++)
+    {
+        const ImDrawList* cmd_list = CmdLists[i];
+        if (int sz = cmd_list->VtxBuffer.Size) memcpy(VtxBuffer.Data + CmdListsVtxOffset[i], cmd_list->VtxBuffer.Data, sz * sizeof(ImDrawVert));
+        if (int sz = cmd_list->IdxBuffer.Size) memcpy(IdxBuffer.Data + CmdListsIdxOffset[i], cmd_list->IdxBuffer.Data, sz * sizeof(ImDrawIdx));
+    }
+}
+
 // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 void ImDrawData::ScaleClipRects(const ImVec2& scale)
 {
@@ -957,6 +1825,7 @@ ImFontAtlas::ImFontAtlas()
     TexPixelsRGBA32 = NULL;
     TexWidth = TexHeight = TexDesiredWidth = 0;
     TexUvWhitePixel = ImVec2(0, 0);
+    TexExtraDataPos = ImVec2(0, 0);
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -981,6 +1850,14 @@ void    ImFontAtlas::ClearInputData()
             Fonts[i]->ConfigDataCount = 0;
         }
     ConfigData.clear();
+
+    // Icons keep their UV coordinates
+    for (int i = 0; i < Icons.Size; i++)
+        if (Icons[i].Pixels)
+        {
+            ImGui::MemFree(Icons[i].Pixels);
+            Icons[i].Pixels = NULL;
+        }
 }
 
 void    ImFontAtlas::ClearTexData()
@@ -1008,6 +1885,7 @@ void    ImFontAtlas::Clear()
     ClearInputData();
     ClearTexData();
     ClearFonts();
+    Icons.clear();
 }
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
@@ -1039,6 +1917,16 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
         unsigned int* dst = TexPixelsRGBA32;
         for (int n = TexWidth * TexHeight; n > 0; n--)
             *dst++ = ((unsigned int)(*src++) << 24) | 0x00FFFFFF;
+
+        // Copy the icons colors over their alpha
+        for (int i = 0; i < Icons.Size; i++)
+        {
+            const Icon& icon = Icons[i];
+            if (!icon.Pixels)
+                continue;
+            for (int y = 0; y < icon.Height; y++)
+                memcpy(TexPixelsRGBA32 + (icon.Y + y) * TexWidth + icon.X, icon.Pixels + y * icon.Width, (size_t)icon.Width * 4);
+        }
     }
 
     *out_pixels = (unsigned char*)TexPixelsRGBA32;
@@ -1047,6 +1935,29 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+int     ImFontAtlas::AddIcon(int width, int height, const unsigned int* pixels)
+{
+    IM_ASSERT(width > 0 && height > 0 && pixels != NULL);
+
+    Icon icon;
+    icon.Width = width;
+    icon.Height = height;
+    icon.Pixels = (unsigned int*)ImGui::MemAlloc((size_t)(width * height * 4));
+    memcpy(icon.Pixels, pixels, (size_t)(width * height * 4));
+    icon.X = icon.Y = 0;
+    icon.Uv0 = icon.Uv1 = ImVec2(0, 0);
+    Icons.push_back(icon);
+    return Icons.Size - 1;
+}
+
+void    ImFontAtlas::GetIconTexUV(int icon_id, ImVec2* out_uv0, ImVec2* out_uv1) const
+{
+    IM_ASSERT(icon_id >= 0 && icon_id < Icons.Size);
+    IM_ASSERT(TexWidth > 0);    // Atlas not built yet
+    *out_uv0 = Icons[icon_id].Uv0;
+    *out_uv1 = Icons[icon_id].Uv1;
+}
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
@@ -1365,12 +2276,27 @@ bool    ImFontAtlas::Build()
     return true;
 }
 
+// Size of the custom data block: two layers of the mouse cursors side by side, plus the white pixel
+static const int TEX_DATA_W = 90;
+static const int TEX_DATA_H = 27;
+
+// Mouse cursors in the custom data block
+static const ImVec2 FONT_ATLAS_MOUSE_CURSOR_DATA[ImGuiMouseCursor_Count_][3] =
+{
+    // Pos ........ Size ......... Offset ......
+    { ImVec2(0,3),  ImVec2(12,19), ImVec2( 0, 0) }, // ImGuiMouseCursor_Arrow
+    { ImVec2(13,0), ImVec2(7,16),  ImVec2( 4, 8) }, // ImGuiMouseCursor_TextInput
+    { ImVec2(31,0), ImVec2(23,23), ImVec2(11,11) }, // ImGuiMouseCursor_Move
+    { ImVec2(21,0), ImVec2( 9,23), ImVec2( 5,11) }, // ImGuiMouseCursor_ResizeNS
+    { ImVec2(55,18),ImVec2(23, 9), ImVec2(11, 5) }, // ImGuiMouseCursor_ResizeEW
+    { ImVec2(73,0), ImVec2(17,17), ImVec2( 9, 9) }, // ImGuiMouseCursor_ResizeNESW
+    { ImVec2(55,0), ImVec2(17,17), ImVec2( 9, 9) }, // ImGuiMouseCursor_ResizeNWSE
+};
+
 void ImFontAtlas::RenderCustomTexData(int pass, void* p_rects)
 {
     // A work of art lies ahead! (. = white layer, X = black layer, others are blank)
     // The white texels on the top left are the ones we'll use everywhere in ImGui to render filled shapes.
-    const int TEX_DATA_W = 90;
-    const int TEX_DATA_H = 27;
     const char texture_data[TEX_DATA_W*TEX_DATA_H+1] =
     {
         "..-         -XXXXXXX-    X    -           X           -XXXXXXX          -          XXXXXXX"
@@ -1411,6 +2337,14 @@ void ImFontAtlas::RenderCustomTexData(int pass, void* p_rects)
         r.w = (TEX_DATA_W*2)+1;
         r.h = TEX_DATA_H+1;
         rects.push_back(r);
+
+        // Followed by one rectangle per icon
+        for (int i = 0; i < Icons.Size; i++)
+        {
+            r.w = Icons[i].Width+1;
+            r.h = Icons[i].Height+1;
+            rects.push_back(r);
+        }
     }
     else if (pass == 1)
     {
@@ -1427,36 +2361,47 @@ void ImFontAtlas::RenderCustomTexData(int pass, void* p_rects)
         const ImVec2 tex_uv_scale(1.0f / TexWidth, 1.0f / TexHeight);
         TexUvWhitePixel = ImVec2((r.x + 0.5f) * tex_uv_scale.x, (r.y + 0.5f) * tex_uv_scale.y);
 
-        // Setup mouse cursors
-        const ImVec2 cursor_datas[ImGuiMouseCursor_Count_][3] =
-        {
-            // Pos ........ Size ......... Offset ......
-            { ImVec2(0,3),  ImVec2(12,19), ImVec2( 0, 0) }, // ImGuiMouseCursor_Arrow
-            { ImVec2(13,0), ImVec2(7,16),  ImVec2( 4, 8) }, // ImGuiMouseCursor_TextInput
-            { ImVec2(31,0), ImVec2(23,23), ImVec2(11,11) }, // ImGuiMouseCursor_Move
-            { ImVec2(21,0), ImVec2( 9,23), ImVec2( 5,11) }, // ImGuiMouseCursor_ResizeNS
-            { ImVec2(55,18),ImVec2(23, 9), ImVec2(11, 5) }, // ImGuiMouseCursor_ResizeEW
-            { ImVec2(73,0), ImVec2(17,17), ImVec2( 9, 9) }, // ImGuiMouseCursor_ResizeNESW
-            { ImVec2(55,0), ImVec2(17,17), ImVec2( 9, 9) }, // ImGuiMouseCursor_ResizeNWSE
-        };
-
-        for (int type = 0; type < ImGuiMouseCursor_Count_; type++)
+        // Mouse cursors are read from there by GetMouseCursorTexData()
+        TexExtraDataPos = ImVec2((float)r.x, (float)r.y);
+
+        // Setup icons. Only their alpha goes into the Alpha8 texture, GetTexDataAsRGBA32() copies the colors.
+        for (int i = 0; i < Icons.Size; i++)
         {
-            ImGuiMouseCursorData& cursor_data = GImGui->MouseCursorData[type];
-            ImVec2 pos = cursor_datas[type][0] + ImVec2((float)r.x, (float)r.y);
-            const ImVec2 size = cursor_datas[type][1];
-            cursor_data.Type = type;
-            cursor_data.Size = size;
-            cursor_data.HotOffset = cursor_datas[type][2];
-            cursor_data.TexUvMin[0] = (pos) * tex_uv_scale;
-            cursor_data.TexUvMax[0] = (pos + size) * tex_uv_scale;
-            pos.x += TEX_DATA_W+1;
-            cursor_data.TexUvMin[1] = (pos) * tex_uv_scale;
-            cursor_data.TexUvMax[1] = (pos + size) * tex_uv_scale;
+            Icon& icon = Icons[i];
+            const stbrp_rect& icon_r = rects[1 + i];
+            IM_ASSERT(icon_r.was_packed);   // Icon wider than the texture?
+            icon.X = icon_r.x;
+            icon.Y = icon_r.y;
+            icon.Uv0 = ImVec2((float)icon.X, (float)icon.Y) * tex_uv_scale;
+            icon.Uv1 = ImVec2((float)(icon.X + icon.Width), (float)(icon.Y + icon.Height)) * tex_uv_scale;
+            IM_ASSERT(icon.Pixels != NULL); // Input data was cleared before building
+            for (int y = 0; y < icon.Height; y++)
+                for (int x = 0; x < icon.Width; x++)
+                    TexPixelsAlpha8[(icon.Y + y) * TexWidth + icon.X + x] = (unsigned char)(icon.Pixels[y * icon.Width + x] >> 24);
         }
     }
 }
 
+// Retrieve the placement and texture coordinates of a mouse cursor, for io.MouseDrawCursor. The white fill is 'out_uv_fill', drawn over the black border 'out_uv_border'.
+// The data lives in the atlas rather than in a context, so any context using this atlas can draw cursors, whichever context was current when the atlas was built.
+bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor, ImVec2* out_offset, ImVec2* out_size, ImVec2 out_uv_fill[2], ImVec2 out_uv_border[2]) const
+{
+    if (cursor < 0 || cursor >= ImGuiMouseCursor_Count_ || TexWidth == 0)
+        return false;
+
+    const ImVec2 tex_uv_scale(1.0f / TexWidth, 1.0f / TexHeight);
+    ImVec2 pos = FONT_ATLAS_MOUSE_CURSOR_DATA[cursor][0] + TexExtraDataPos;
+    const ImVec2 size = FONT_ATLAS_MOUSE_CURSOR_DATA[cursor][1];
+    *out_size = size;
+    *out_offset = FONT_ATLAS_MOUSE_CURSOR_DATA[cursor][2];
+    out_uv_fill[0] = pos * tex_uv_scale;
+    out_uv_fill[1] = (pos + size) * tex_uv_scale;
+    pos.x += TEX_DATA_W + 1;
+    out_uv_border[0] = pos * tex_uv_scale;
+    out_uv_border[1] = (pos + size) * tex_uv_scale;
+    return true;
+}
+
 // Retrieve list of range (2 int per range, values are inclusive)
 const ImWchar*   ImFontAtlas::GetGlyphRangesDefault()
 {
@@ -2000,10 +2945,10 @@ void ImFont::RenderText(float size, ImVec2 pos, ImU32 col, const ImVec4& clip_re
                     {
                         idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
                         idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
-                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                        ImDrawVertWrite(&vtx_write[0], ImVec2(x1, y1), ImVec2(u1, v1), col);
+                        ImDrawVertWrite(&vtx_write[1], ImVec2(x2, y1), ImVec2(u2, v1), col);
+                        ImDrawVertWrite(&vtx_write[2], ImVec2(x2, y2), ImVec2(u2, v2), col);
+                        ImDrawVertWrite(&vtx_write[3], ImVec2(x1, y2), ImVec2(u1, v2), col);
                         vtx_write += 4;
                         vtx_current_idx += 4;
                         idx_write += 6;
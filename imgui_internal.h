@@ -28,10 +28,10 @@ struct ImGuiColMod;
 struct ImGuiStyleMod;
 struct ImGuiGroupData;
 struct ImGuiSimpleColumns;
+struct ImGuiFrameArena;
 struct ImGuiDrawContext;
 struct ImGuiTextEditState;
 struct ImGuiIniData;
-struct ImGuiMouseCursorData;
 struct ImGuiPopupRef;
 struct ImGuiState;
 struct ImGuiWindow;
@@ -70,7 +70,22 @@ namespace ImGuiStb
 // Context
 //-----------------------------------------------------------------------------
 
-extern IMGUI_API ImGuiState*  GImGui;
+// Current context. Define IMGUI_USE_THREAD_LOCAL_CONTEXT in imconfig.h to make it thread-local, so each thread can use ImGui::SetCurrentContext() independently.
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+#ifdef _MSC_VER
+#define IMGUI_THREAD_LOCAL  __declspec(thread)
+#else
+#define IMGUI_THREAD_LOCAL  __thread
+#endif
+#else
+#define IMGUI_THREAD_LOCAL
+#endif
+
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+extern IMGUI_THREAD_LOCAL ImGuiState* GImGui;       // Not exported: MSVC rejects thread-local dllimport/dllexport variables (C2492). Other modules can use ImGui::GetCurrentContext().
+#else
+extern IMGUI_API ImGuiState* GImGui;
+#endif
 
 //-----------------------------------------------------------------------------
 // Helpers
@@ -227,6 +242,14 @@ struct IMGUI_API ImRect
     }
 };
 
+// Bounding box in screen space of a rectangle in the local space of a ImDrawCmd::Transform
+static inline ImRect ImDrawCmdTransformRect(const ImVec4& transform, const ImRect& r)
+{
+    const ImVec2 a(r.Min.x * transform.x + transform.z, r.Min.y * transform.y + transform.w);
+    const ImVec2 b(r.Max.x * transform.x + transform.z, r.Max.y * transform.y + transform.w);
+    return ImRect(ImMin(a, b), ImMax(a, b));
+}
+
 // Stacked color modifier, backup of modified data so we can restore it
 struct ImGuiColMod
 {
@@ -267,6 +290,25 @@ struct IMGUI_API ImGuiSimpleColumns
     float               CalcExtraSpace(float avail_w);
 };
 
+// Per-frame bump allocator for transient data (formatted text, tooltip). Everything is released at once by Reset(), called in NewFrame().
+// Blocks are kept across frames and merged into a single block when a frame needed more than one, so steady-state frames don't allocate.
+struct IMGUI_API ImGuiFrameArena
+{
+    ImVector<char*>     Blocks;                         // Only the last block is being allocated from
+    ImVector<int>       BlockSizes;
+    int                 CurrentOffset;                  // Offset of first free byte in Blocks.back()
+    void*               LastAlloc;                      // For Free() to rewind the most recent allocation
+
+    ImGuiFrameArena()                                   { CurrentOffset = 0; LastAlloc = NULL; }
+    void*               Alloc(int size);
+    void                Free(void* ptr);                // Only rewinds if 'ptr' is the most recent allocation, otherwise memory is reclaimed on Reset()
+    char*               FormatV(const char* fmt, va_list args, const char** out_end = NULL);
+    void                Reset();
+    void                Clear();                        // Free all blocks
+    int                 GetUsedSize() const;
+    int                 GetCapacity() const;
+};
+
 // Internal state of the currently focused/edited text input box
 struct IMGUI_API ImGuiTextEditState
 {
@@ -301,16 +343,6 @@ struct ImGuiIniData
     bool                Collapsed;
 };
 
-// Mouse cursor data (used when io.MouseDrawCursor is set)
-struct ImGuiMouseCursorData
-{
-    ImGuiMouseCursor    Type;
-    ImVec2              HotOffset;
-    ImVec2              Size;
-    ImVec2              TexUvMin[2];
-    ImVec2              TexUvMax[2];
-};
-
 // Storage for current popup stack
 struct ImGuiPopupRef
 {
@@ -332,7 +364,7 @@ struct ImGuiState
     ImFont*                 Font;                               // (Shortcut) == FontStack.empty() ? IO.Font : FontStack.back()
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize()
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Size of characters.
-    ImVec2                  FontTexUvWhitePixel;                // (Shortcut) == Font->TexUvForWhite
+    ImDrawListSharedData    DrawListSharedData;                 // Font, FontSize, white pixel UV and style settings read by the draw lists of this context
 
     float                   Time;
     int                     FrameCount;
@@ -340,6 +372,7 @@ struct ImGuiState
     int                     FrameCountRendered;
     ImVector<ImGuiWindow*>  Windows;
     ImVector<ImGuiWindow*>  WindowsSortBuffer;
+    ImGuiStorage            WindowsById;                        // Map window ID -> ImGuiWindow*, for FindWindowByName(). Binary search: O(log N) lookups, O(1) with IMGUI_STORAGE_USE_HASH_TABLE
     ImGuiWindow*            CurrentWindow;                      // Being drawn into
     ImVector<ImGuiWindow*>  CurrentWindowStack;
     ImGuiWindow*            FocusedWindow;                      // Will catch keyboard inputs
@@ -356,6 +389,7 @@ struct ImGuiState
     ImGuiWindow*            ActiveIdWindow;
     ImGuiWindow*            MovedWindow;                        // Track the child window we clicked on to move a window. Pointer is only valid if ActiveID is the "#MOVE" identifier of a window.
     ImVector<ImGuiIniData>  Settings;                           // .ini Settings
+    ImGuiStorage            SettingsIdxById;                    // Map window ID -> index+1 into Settings[] (0 = not found), for FindWindowSettings(). O(log N) lookups like WindowsById. We store indices because Settings[] may be reallocated.
     float                   SettingsDirtyTimer;                 // Save .ini settinngs on disk when time reaches zero
     int                     DisableHideTextAfterDoubleHash;
     ImVector<ImGuiColMod>   ColorModifiers;                     // Stack for PushStyleColor()/PopStyleColor()
@@ -380,10 +414,10 @@ struct ImGuiState
     // Render
     ImDrawData              RenderDrawData;                     // Main ImDrawData instance to pass render information to the user
     ImVector<ImDrawList*>   RenderDrawLists[3];
+    ImVector<ImRect>        RenderOccluders;                    // Temporary storage for the occlusion pass in Render()
     float                   ModalWindowDarkeningRatio;
     ImDrawList              OverlayDrawList;                    // Optional software render of mouse cursors, if io.MouseDrawCursor is set + a few debug overlays
     ImGuiMouseCursor        MouseCursor;
-    ImGuiMouseCursorData    MouseCursorData[ImGuiMouseCursor_Count_];
 
     // Widget state
     ImGuiTextEditState      InputTextState;
@@ -396,7 +430,7 @@ struct ImGuiState
     float                   DragSpeedScaleSlow;
     float                   DragSpeedScaleFast;
     ImVec2                  ScrollbarClickDeltaToGrabCenter;   // Distance between mouse and center of grab box, normalized in parent space. Use storage?
-    char                    Tooltip[1024];
+    const char*             Tooltip;                            // Allocated in FrameArena
     char*                   PrivateClipboard;                   // If no custom clipboard handler is defined
 
     // Logging
@@ -410,16 +444,22 @@ struct ImGuiState
     float                   FramerateSecPerFrame[120];          // calculate estimate of framerate for user
     int                     FramerateSecPerFrameIdx;
     float                   FramerateSecPerFrameAccum;
+    int                     IdleInputFrame;                     // Last frame with input changes. We request one more frame after it to let the layout settle.
+    ImVec2                  IdlePrevDisplaySize;                // Input state of the last frame that are not otherwise kept, for IsNewFrameNeeded()
+    bool                    IdlePrevKeyMods[3];
+    double                  InputEventsMouseClickTime[5];       // Timestamp of the mouse button down events applied this frame, -1.0 if none or unknown
+    double                  InputEventsMouseClickedTime[5];     // Timestamp of the click recorded in io.MouseClickedTime[], -1.0 if unknown
+    bool                    InputEventsKeysUsed;                // Keys are fed with ImGuiIO::AddKeyEvent(): only update the durations of KeysDownTracked[]
+    ImVector<int>           KeysDownTracked;                    // Keys which are down, or were down last frame
     bool                    CaptureMouseNextFrame;              // explicit capture via CaptureInputs() sets those flags
     bool                    CaptureKeyboardNextFrame;
-    char                    TempBuffer[1024*3+1];               // temporary text buffer
+    ImGuiFrameArena         FrameArena;                         // Transient allocations for the current frame (formatted text, tooltip)
 
     ImGuiState()
     {
         Initialized = false;
         Font = NULL;
         FontSize = FontBaseSize = 0.0f;
-        FontTexUvWhitePixel = ImVec2(0.0f, 0.0f);
 
         Time = 0.0f;
         FrameCount = 0;
@@ -459,10 +499,11 @@ struct ImGuiState
         DragSpeedScaleSlow = 0.01f;
         DragSpeedScaleFast = 10.0f;
         ScrollbarClickDeltaToGrabCenter = ImVec2(0.0f, 0.0f);
-        memset(Tooltip, 0, sizeof(Tooltip));
+        Tooltip = NULL;
         PrivateClipboard = NULL;
 
         ModalWindowDarkeningRatio = 0.0f;
+        OverlayDrawList._Data = &DrawListSharedData;
         OverlayDrawList._OwnerName = "##Overlay"; // Give it a name for debugging
         MouseCursor = ImGuiMouseCursor_Arrow;
 
@@ -475,6 +516,12 @@ struct ImGuiState
         memset(FramerateSecPerFrame, 0, sizeof(FramerateSecPerFrame));
         FramerateSecPerFrameIdx = 0;
         FramerateSecPerFrameAccum = 0.0f;
+        IdleInputFrame = -1;
+        IdlePrevDisplaySize = ImVec2(-1.0f, -1.0f);
+        IdlePrevKeyMods[0] = IdlePrevKeyMods[1] = IdlePrevKeyMods[2] = false;
+        for (int i = 0; i < IM_ARRAYSIZE(InputEventsMouseClickTime); i++)
+            InputEventsMouseClickTime[i] = InputEventsMouseClickedTime[i] = -1.0;
+        InputEventsKeysUsed = false;
         CaptureMouseNextFrame = CaptureKeyboardNextFrame = false;
     }
 };
@@ -598,12 +645,15 @@ struct IMGUI_API ImGuiWindow
     ImVector<ImGuiID>       IDStack;                            // ID stack. ID are hashes seeded with the value at the top of the stack
     ImRect                  ClipRect;                           // = DrawList->clip_rect_stack.back(). Scissoring / clipping rectangle. x1, y1, x2, y2.
     ImRect                  ClippedWindowRect;                  // = ClipRect just after setup in Begin()
+    ImRect                  OpaqueRect;                         // Area fully covered by the window background this frame (empty if the background is translucent or rounded). Windows behind it are not rendered.
+    bool                    Occluded;                           // Set by Render() when the window is hidden behind the OpaqueRect of a window in front of it
     int                     LastFrameDrawn;
     float                   ItemWidthDefault;
     ImGuiSimpleColumns      MenuColumns;                        // Simplified columns storage for menu items
     ImGuiStorage            StateStorage;
     float                   FontWindowScale;                    // Scale multiplier per-window
     ImDrawList*             DrawList;
+    ImVector<ImDrawList*>   UserDrawLists;                      // Submitted with AddWindowDrawList() this frame, rendered after DrawList
     ImGuiWindow*            RootWindow;
     ImGuiWindow*            RootNonPopupWindow;
 
@@ -621,6 +671,9 @@ public:
 
     ImGuiID     GetID(const char* str, const char* str_end = NULL);
     ImGuiID     GetID(const void* ptr);
+#ifdef IMGUI_USE_CONSTEXPR_ID
+    ImGuiID     GetID(ImGuiIdHash id_hash);
+#endif
 
     ImRect      Rect() const                            { return ImRect(Pos.x, Pos.y, Pos.x+Size.x, Pos.y+Size.y); }
     float       CalcFontSize() const                    { return GImGui->FontBaseSize * FontWindowScale; }